@@ -0,0 +1,382 @@
+#define _POSIX_C_SOURCE 199309L
+#include "jsonw.h"
+#include "jsonw_par.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// usage: bin/bench [-r reps] [-w warmups] [-t threads] [corpus.json ...]
+//
+// times each parser over every corpus given, such as twitter.json, canada.json
+// and citm_catalog.json, and over a generated NDJSON log and a generated deeply
+// nested text. prints one tab-separated line per corpus and parser, with the
+// median over `reps` timed runs that follow `warmups` untimed ones. the NDJSON
+// log is also validated in parallel on `threads` threads
+
+typedef struct {
+  char *json; // start of the construct
+  char *name; // key to look up, or unescaped string
+  size_t idx; // subscript to index
+  char *val;  // array or object the construct is in, for tapes
+} op;
+
+typedef struct {
+  op *ops;
+  size_t len, cap, bytes;
+} ops;
+
+static ops strings, numbers, lookups, indices;
+static char *pool; // unescaped strings
+static size_t pooled, pool_size;
+static char *volatile sink;
+static int reps = 5, warmups = 1, threads = 1;
+
+static void push(ops *ops, size_t bytes, op op) {
+  if (ops->len == ops->cap &&
+      (ops->ops = realloc(ops->ops, (ops->cap = ops->cap * 2 + 64) *
+                                        sizeof(*ops->ops))) == NULL)
+    perror("realloc"), exit(EXIT_FAILURE);
+  ops->ops[ops->len++] = op, ops->bytes += bytes;
+}
+
+static char *unescape(char *json) {
+  char *str = pool + pooled;
+  char *end = jsonw_unescape(str, pool_size - pooled, jsonw_beginstr(json));
+  pooled += strlen(str) + 1;
+  return end ? str : NULL;
+}
+
+// records every string, number, array and object in the value `json`
+static char *collect(char *json) {
+  jsonw_ty type;
+  char *end = jsonw_value(&type, json), *last = NULL, *val = json;
+  size_t len = 0;
+  if (end == NULL)
+    return NULL;
+
+  switch (type) {
+  case JSONW_STRING:
+    push(&strings, end - json, (op){json, unescape(json), 0, NULL});
+    break;
+  case JSONW_NUMBER:
+    push(&numbers, end - json, (op){json, NULL, 0, NULL});
+    break;
+  case JSONW_ARRAY:
+    for (char *elem = jsonw_beginarr(json); elem; elem = jsonw_element(elem))
+      collect(elem), len++;
+    // the bytes of the elements skipped over to get to the last one
+    if (len && (json = jsonw_beginarr(json)))
+      push(&indices, jsonw_index(len - 1, json) - json,
+           (op){json, NULL, len - 1, val});
+    break;
+  case JSONW_OBJECT:
+    for (char *memb = jsonw_beginobj(json); memb; memb = jsonw_member(memb))
+      collect(memb), collect(jsonw_name(memb)), last = memb;
+    if (last && (last = unescape(last)) && (json = jsonw_beginobj(json)))
+      push(&lookups, jsonw_lookup(last, json) - json,
+           (op){json, last, 0, val});
+    break;
+  default:
+    break;
+  }
+  return end;
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int cmp(const void *a, const void *b) {
+  return (*(double *)a > *(double *)b) - (*(double *)a < *(double *)b);
+}
+
+// times the statement in `...` over the `OPS` ops of `BYTES` bytes in total
+#define BENCH(CORPUS, FUNC, BYTES, OPS, ...)                                   \
+  do {                                                                         \
+    double *ns = malloc(reps * sizeof(*ns));                                   \
+    for (int rep = -warmups; rep < reps; rep++) {                              \
+      double start = now();                                                    \
+      __VA_ARGS__;                                                             \
+      if (rep >= 0)                                                            \
+        ns[rep] = now() - start;                                               \
+    }                                                                          \
+    qsort(ns, reps, sizeof(*ns), cmp);                                         \
+    double med = ns[reps / 2];                                                 \
+    if (OPS)                                                                   \
+      printf("%s\t%s\t%zu\t%zu\t%.1f\t%.1f\n", CORPUS, FUNC, (size_t)(BYTES), \
+             (size_t)(OPS), med / (OPS), (BYTES) / med * 1e3);                 \
+    free(ns);                                                                  \
+  } while (0)
+
+static void bench(char *corpus, char *buf, size_t size) {
+  strings.len = numbers.len = lookups.len = indices.len = 0;
+  strings.bytes = numbers.bytes = lookups.bytes = indices.bytes = 0;
+  if ((pool = realloc(pool, pool_size = size + 1)) == NULL)
+    perror("realloc"), exit(EXIT_FAILURE);
+  pooled = 0;
+
+  // corpora are sequences of texts, such that NDJSON logs are handled as well
+  size_t texts = 0;
+  for (char *json = jsonw_ws(buf); json && *json; json = jsonw_ws(json))
+    json = collect(json), texts++;
+
+  char *end = buf + size, *out = malloc(6 * size + 1);
+  if (out == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+
+  BENCH(corpus, "jsonw_text", size, texts, {
+    for (char *json = buf; json && json != end;)
+      sink = json = jsonw_text(NULL, json);
+  });
+  if (texts == 1)
+    BENCH(corpus, "jsonw_text_par", size, 1,
+          sink = jsonw_text_par(NULL, threads, end, buf));
+  BENCH(corpus, "jsonw_utf8", size, 1, sink = jsonw_utf8_n(end, buf));
+  BENCH(corpus, "jsonw_value_u", size, texts, {
+    for (char *json = jsonw_ws(buf); json && json != end;)
+      sink = json = jsonw_ws(jsonw_value_u(NULL, end, json));
+  });
+  BENCH(corpus, "jsonw_string", strings.bytes, strings.len, {
+    for (size_t i = 0; i < strings.len; i++)
+      sink = jsonw_string(NULL, strings.ops[i].json);
+  });
+  BENCH(corpus, "jsonw_number", numbers.bytes, numbers.len, {
+    double num;
+    for (size_t i = 0; i < numbers.len; i++)
+      sink = jsonw_number(&num, numbers.ops[i].json);
+  });
+  BENCH(corpus, "jsonw_lookup", lookups.bytes, lookups.len, {
+    for (size_t i = 0; i < lookups.len; i++)
+      sink = jsonw_lookup(lookups.ops[i].name, lookups.ops[i].json);
+  });
+  BENCH(corpus, "jsonw_index", indices.bytes, indices.len, {
+    for (size_t i = 0; i < indices.len; i++)
+      sink = jsonw_index(indices.ops[i].idx, indices.ops[i].json);
+  });
+  BENCH(corpus, "jsonw_escape", strings.bytes, strings.len, {
+    for (size_t i = 0; i < strings.len; i++)
+      if (strings.ops[i].name)
+        sink = jsonw_escape(out, 6 * size + 1, strings.ops[i].name);
+  });
+  // writers fail once `out` is full rather than overflow it
+  BENCH(corpus, "jsonw_putstring", strings.bytes, strings.len, {
+    jsonw_writer w = {.buf = out, .size = 6 * size + 1};
+    for (size_t i = 0; i < strings.len; i++)
+      if (strings.ops[i].name)
+        jsonw_putstring(strings.ops[i].name, &w);
+    sink = w.buf;
+  });
+  BENCH(corpus, "jsonw_putnumber", numbers.bytes, numbers.len, {
+    jsonw_writer w = {.buf = out, .size = 6 * size + 1};
+    double num;
+    for (size_t i = 0; i < numbers.len; i++)
+      jsonw_number(&num, numbers.ops[i].json), jsonw_putnumber(num, &w);
+    sink = w.buf;
+  });
+  BENCH(corpus, "jsonw_unescape", strings.bytes, strings.len, {
+    for (size_t i = 0; i < strings.len; i++)
+      sink = jsonw_unescape(out, size + 1, strings.ops[i].json + 1);
+  });
+  BENCH(corpus, "jsonw_decode", strings.bytes, strings.len, {
+    for (size_t i = 0; i < strings.len; i++)
+      sink = jsonw_decode(out, size + 1, strings.ops[i].json + 1);
+  });
+
+  // tapes hold a single text, and take arrays and objects themselves
+  jsonw_tape tape = {.ents = malloc((size + 1) * sizeof(jsonw_entry)),
+                     .cap = size + 1,
+                     .slots = malloc((size + 1) * sizeof(jsonw_slot)),
+                     .slotcap = size + 1};
+  if (tape.ents == NULL || tape.slots == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  if (texts == 1) {
+    BENCH(corpus, "jsonw_build", size, 1, sink = jsonw_build(&tape, end, buf));
+    BENCH(corpus, "jsonw_lookup_t", lookups.bytes, lookups.len, {
+      for (size_t i = 0; i < lookups.len; i++)
+        sink = jsonw_lookup_t(lookups.ops[i].name, &tape, lookups.ops[i].val);
+    });
+    BENCH(corpus, "jsonw_index_t", indices.bytes, indices.len, {
+      for (size_t i = 0; i < indices.len; i++)
+        sink = jsonw_index_t(indices.ops[i].idx, &tape, indices.ops[i].val);
+    });
+  }
+
+  free(out), free(tape.ents), free(tape.slots);
+}
+
+static size_t count_texts(char *buf, size_t size) {
+  size_t texts = 0;
+  for (char *doc = jsonw_ws_n(buf + size, buf); doc && doc != buf + size;
+       doc = jsonw_document_n(buf + size, doc))
+    texts++;
+  return texts;
+}
+
+// a log of `lines` records, one per line
+static char *ndjson(size_t *size, int lines) {
+  char *buf = malloc(lines * 256), *b = buf;
+  if (buf == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  for (int i = 0; i < lines; i++)
+    b += sprintf(b,
+                 "{\"ts\":%d.%03d,\"level\":\"%s\",\"id\":%d,\"lat\":%.6f,"
+                 "\"msg\":\"request \\\"GET /item/%d\\\" took %dms\","
+                 "\"tags\":[\"api\",\"v%d\"],\"ok\":%s}\n",
+                 1700000000 + i, i % 1000, i % 7 ? "info" : "warn", i,
+                 (i % 18000) / 100.0 - 90, i * 7 % 100000, i % 250, i % 3,
+                 i % 5 ? "true" : "false");
+  return *size = b - buf, buf;
+}
+
+// an array of `count` values nested `depth` levels deep
+static char *deep(size_t *size, int count, int depth) {
+  char *buf = malloc(count * (depth * 12 + 16) + 3), *b = buf;
+  if (buf == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  *b++ = '[';
+  for (int i = 0; i < count; i++) {
+    if (i)
+      *b++ = ',';
+    for (int d = 0; d < depth; d++)
+      b += sprintf(b, d % 2 ? "{\"k\":" : "[%d,", d);
+    b += sprintf(b, "null");
+    for (int d = depth; d-- > 0;)
+      *b++ = d % 2 ? '}' : ']';
+  }
+  *b++ = ']', *b = '\0';
+  return *size = b - buf, buf;
+}
+
+// an array of `count` coordinates, with digits like those of canada.json
+static char *coords(size_t *size, int count) {
+  char *buf = malloc(count * 24 + 3), *b = buf;
+  if (buf == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  *b++ = '[';
+  for (int i = 0; i < count; i++)
+    b += sprintf(b, "%s%.15g", i ? "," : "",
+                 i % 36000 * 7919 % 36000 / 100.0 - 180 + i % 1000 * 1e-12);
+  *b++ = ']', *b = '\0';
+  return *size = b - buf, buf;
+}
+
+int main(int argc, char **argv) {
+  for (char *prog = *argv; argv[1] && argv[1][0] == '-'; argv += 2) {
+    int *opt = strcmp(argv[1], "-r") == 0   ? &reps
+               : strcmp(argv[1], "-w") == 0 ? &warmups
+               : strcmp(argv[1], "-t") == 0 ? &threads
+                                            : NULL;
+    if (opt == NULL || argv[2] == NULL ||
+        (*opt = atoi(argv[2])) < (opt != &warmups))
+      fprintf(stderr,
+              "usage: %s [-r reps] [-w warmups] [-t threads] "
+              "[corpus.json ...]\n",
+              prog),
+          exit(EXIT_FAILURE);
+  }
+
+  printf("corpus\tfunction\tbytes\tops\tns_op\tmb_s\n");
+
+  char *buf = NULL;
+  while (*++argv) {
+    long size;
+    FILE *fp = fopen(*argv, "r");
+    if (fp == NULL)
+      perror("fopen"), exit(EXIT_FAILURE);
+    if (fseek(fp, 0, SEEK_END) == -1)
+      perror("fseek"), exit(EXIT_FAILURE);
+    if ((size = ftell(fp)) == -1)
+      perror("ftell"), exit(EXIT_FAILURE);
+    rewind(fp);
+
+    buf = realloc(buf, size + 1);
+    if (fread(buf, 1, size, fp) != size)
+      perror("fread"), exit(EXIT_FAILURE);
+    buf[size] = '\0';
+    if (fclose(fp) == EOF)
+      perror("fclose"), exit(EXIT_FAILURE);
+
+    char *name = strrchr(*argv, '/');
+    bench(name ? name + 1 : *argv, buf, size);
+  }
+
+  size_t size;
+  free(buf), buf = ndjson(&size, 100000);
+  bench("ndjson", buf, size);
+  size_t records = count_texts(buf, size);
+  BENCH("ndjson", "jsonw_ndjson", size, records, {
+    size_t invalid = jsonw_ndjson(NULL, NULL, NULL, threads, buf + size, buf);
+    sink = invalid ? NULL : buf;
+  });
+  char *names[] = {"level", "id", "msg", "ok"};
+  jsonw_keys keys;
+  jsonw_hashkeys(&keys, names, sizeof(names) / sizeof(*names));
+  jsonw_shape shape = {.keys = &keys};
+  BENCH("ndjson", "jsonw_lookups", size, records, {
+    char *vals[4];
+    for (char *json = buf; json && json != buf + size;)
+      sink = json = jsonw_endobj(
+          jsonw_lookups(vals, &keys, false, jsonw_beginobj(json)));
+  });
+  BENCH("ndjson", "jsonw_shaped", size, records, {
+    char *vals[4];
+    for (char *json = buf; json && json != buf + size;)
+      sink = json = jsonw_endobj(
+          jsonw_shaped(vals, &shape, false, jsonw_beginobj(json)));
+  });
+  char prog[64], *progs[3], *pc = prog;
+  char *paths[] = {"level", "tags[1]", "ok"};
+  for (int i = 0; i < 3; i++)
+    progs[i] = pc, pc = jsonw_compile(pc, prog + sizeof(prog) - pc, paths[i]);
+  BENCH("ndjson", "jsonw_query", size, records, {
+    char *vals[3];
+    for (char *json = buf; json && json != buf + size;)
+      sink = json = jsonw_query_n(vals, progs, 3, buf + size, json);
+  });
+  // project the same keys into columns, sequentially and in parallel
+  double *lats = malloc(records * sizeof(*lats));
+  int64_t *ids = malloc(records * sizeof(*ids));
+  jsonw_span *levels = malloc(records * sizeof(*levels)),
+             *msgs = malloc(records * sizeof(*msgs));
+  unsigned char *valid = malloc(4 * (records / 8 + 1));
+  if (!lats || !ids || !levels || !msgs || !valid)
+    perror("malloc"), exit(EXIT_FAILURE);
+  char *fields[] = {"lat", "id", "level", "msg"};
+  jsonw_keys field_keys;
+  jsonw_hashkeys(&field_keys, fields, 4);
+  jsonw_shape field_shape = {.keys = &field_keys};
+  jsonw_column cols[] = {
+      {JSONW_COL_DOUBLE, lats, valid},
+      {JSONW_COL_INT64, ids, valid + records / 8 + 1},
+      {JSONW_COL_SPAN, levels, valid + 2 * (records / 8 + 1)},
+      {JSONW_COL_SPAN, msgs, valid + 3 * (records / 8 + 1)},
+  };
+  BENCH("ndjson", "jsonw_project", size, records, {
+    size_t len = jsonw_project_n(cols, &field_shape, records, buf + size, buf);
+    sink = len == records ? buf : NULL;
+  });
+  BENCH("ndjson", "jsonw_project_par", size, records, {
+    size_t len =
+        jsonw_project_par(cols, &field_keys, records, threads, buf + size, buf);
+    sink = len == records ? buf : NULL;
+  });
+  free(lats), free(ids), free(levels), free(msgs), free(valid);
+  size_t count;
+  free(buf), buf = coords(&size, 1000000);
+  bench("coords", buf, size);
+  double *nums = malloc(1000000 * sizeof(*nums));
+  if (nums == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  BENCH("coords", "jsonw_numbers", size, 1000000,
+        sink = jsonw_numbers_n(nums, 1000000, &count, buf + size, buf));
+  free(nums);
+  // one level less than the limit, to leave room for the outer array
+  free(buf), buf = deep(&size, 1000, JSONW_MAX_DEPTH - 1);
+  bench("deep", buf, size);
+
+  free(buf), free(pool);
+  free(strings.ops), free(numbers.ops), free(lookups.ops), free(indices.ops);
+}
@@ -1,7 +1,27 @@
 #include "jsonw.h"
-#include <ctype.h>
+#include <float.h>
+#include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
+#ifdef JSONW_STATS
+#include <stdio.h>
+#endif
+
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) && defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
+
 #define OUT_PARAM(TYPE, IDENT)                                                 \
   TYPE _out_param_##IDENT;                                                     \
   if (IDENT == NULL)                                                           \
@@ -10,239 +30,2011 @@
 #define JSON_ESCAPES "\"\\/bfnrt"
 #define JSON_CODEPTS "\"\\/\b\f\n\r\t"
 
+// every parser is bounded by `end`, and reading `end` itself yields a NUL.
+// a NULL `end` is never reached, so parsing stops at the terminating NUL
+#define AT(JSON) ((JSON) != end ? *(JSON) : '\0')
+
+// instrumentation. a parser's call counts as a failure until `STAT_OK` sees it
+// succeed, so that its early exits need no bookkeeping
+#ifdef JSONW_STATS
+#if __STDC_VERSION__ >= 201112L
+static _Thread_local jsonw_stats jsonw_tls;
+#else
+static __thread jsonw_stats jsonw_tls;
+#endif
+
+static void jsonw_call(jsonw_stat id, char *json) {
+  if (json)
+    jsonw_tls.parsers[id].calls++, jsonw_tls.parsers[id].fails++;
+}
+
+static char *jsonw_ok(jsonw_stat id, char *from, char *json) {
+  if (from && json)
+    jsonw_tls.parsers[id].fails--, jsonw_tls.parsers[id].bytes += json - from;
+  return json;
+}
+
+#define STAT_CALL(ID, JSON)                                                    \
+  char *_stat_from = (JSON);                                                   \
+  jsonw_call(JSONW_STAT_##ID, _stat_from)
+#define STAT_OK(ID, JSON) jsonw_ok(JSONW_STAT_##ID, _stat_from, (JSON))
+#define STAT_MISS(JSON) ((JSON) ? 0 : jsonw_tls.misses++)
+#define STAT_DEPTH(DEPTH)                                                      \
+  (jsonw_tls.depth < (DEPTH) ? jsonw_tls.depth = (DEPTH) : 0)
+
+jsonw_stats *jsonw_getstats(void) { return &jsonw_tls; }
+
+void jsonw_resetstats(void) { memset(&jsonw_tls, 0, sizeof(jsonw_tls)); }
+
+int jsonw_dumpstats(char *buf, size_t size) {
+  static char *names[JSONW_STAT_LEN] = {
+      "null",   "boolean", "number", "int64",     "uint64",     "string",
+      "rawstr", "array",   "object", "primitive", "structured", "value",
+      "text",   "find",    "lookups", "shaped"};
+  size_t len = 0;
+  int n;
+
+#define PRINT(...)                                                             \
+  if ((n = snprintf(len < size ? buf + len : NULL,                             \
+                    len < size ? size - len : 0, __VA_ARGS__)) < 0)            \
+    return -1;                                                                 \
+  else                                                                         \
+    len += n
+
+  PRINT("parser\tcalls\tfails\tbytes\n");
+  for (int i = 0; i < JSONW_STAT_LEN; i++)
+    PRINT("%s\t%llu\t%llu\t%llu\n", names[i],
+          (unsigned long long)jsonw_tls.parsers[i].calls,
+          (unsigned long long)jsonw_tls.parsers[i].fails,
+          (unsigned long long)jsonw_tls.parsers[i].bytes);
+  PRINT("misses\t%llu\n", (unsigned long long)jsonw_tls.misses);
+  PRINT("depth\t%zu\n", jsonw_tls.depth);
+
+#undef PRINT
+
+  return len;
+}
+#else
+#define STAT_CALL(ID, JSON) (void)0
+#define STAT_OK(ID, JSON) (JSON)
+#define STAT_MISS(JSON) (void)0
+#define STAT_DEPTH(DEPTH) (void)0
+#endif
+
 // basic parsers
 
-char *jsonw_litchr(char chr, char *json) {
-  if (json && *json == chr)
+char *jsonw_litchr_n(char chr, char *end, char *json) {
+  if (json && AT(json) == chr)
     return ++json;
   return NULL;
 }
 
-char *jsonw_litstr(char *str, char *json) {
-  if (json && strncmp(json, str, strlen(str)) == 0)
-    return json + strlen(str);
-  return NULL;
+char *jsonw_litstr_n(char *str, char *end, char *json) {
+  if (json == NULL)
+    return NULL;
+  for (; *str; str++, json++)
+    if (AT(json) != *str)
+      return NULL;
+  return json;
 }
 
 // characters
 
-char *jsonw_ws(char *json) {
-  return json ? json + strspn(json, " \t\n\r") : json;
+char *jsonw_ws_n(char *end, char *json) {
+  if (json)
+    while (AT(json) == ' ' || AT(json) == '\t' || AT(json) == '\n' ||
+           AT(json) == '\r')
+      json++;
+  return json;
 }
 
-#define WSCHRWS(CHR, JSON) jsonw_ws(jsonw_litchr(CHR, jsonw_ws(JSON)))
+#define WSCHRWS(CHR, JSON)                                                     \
+  jsonw_ws_n(end, jsonw_litchr_n(CHR, end, jsonw_ws_n(end, JSON)))
 
-char *jsonw_beginarr(char *json) { return WSCHRWS('[', json); }
-char *jsonw_endarr(char *json) { return WSCHRWS(']', json); }
-char *jsonw_beginobj(char *json) { return WSCHRWS('{', json); }
-char *jsonw_endobj(char *json) { return WSCHRWS('}', json); }
-char *jsonw_namesep(char *json) { return WSCHRWS(':', json); }
-char *jsonw_valuesep(char *json) { return WSCHRWS(',', json); }
-char *jsonw_beginstr(char *json) { return jsonw_litchr('"', json); }
-char *jsonw_endstr(char *json) { return jsonw_litchr('"', json); }
+char *jsonw_beginarr_n(char *end, char *json) { return WSCHRWS('[', json); }
+char *jsonw_endarr_n(char *end, char *json) { return WSCHRWS(']', json); }
+char *jsonw_beginobj_n(char *end, char *json) { return WSCHRWS('{', json); }
+char *jsonw_endobj_n(char *end, char *json) { return WSCHRWS('}', json); }
+char *jsonw_namesep_n(char *end, char *json) { return WSCHRWS(':', json); }
+char *jsonw_valuesep_n(char *end, char *json) { return WSCHRWS(',', json); }
+char *jsonw_beginstr_n(char *end, char *json) {
+  return jsonw_litchr_n('"', end, json);
+}
+char *jsonw_endstr_n(char *end, char *json) {
+  return jsonw_litchr_n('"', end, json);
+}
 
 #undef WSCHRWS
 
+// scanning
+
+// whether `chr` ends a run of characters that stand for themselves in a
+// string literal. this includes the terminating NUL
+#define STR_STOP(CHR)                                                          \
+  ((CHR) == '"' || (CHR) == '\\' || (unsigned char)(CHR) < ' ')
+
+// `also` is one more character that ends runs, or '"' for none
+#if defined(__GNUC__) && defined(__AVX2__)
+#define BLOCK 32
+#define STRIDE 1
+static uint64_t jsonw_strmask(char *block, char also) {
+  __m256i v = _mm256_loadu_si256((__m256i *)block);
+  __m256i ctrl =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1f)), v);
+  __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+  __m256i bslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+  __m256i other = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(also));
+  return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(
+      _mm256_or_si256(ctrl, other), _mm256_or_si256(quote, bslash)));
+}
+#elif defined(__GNUC__) && defined(__SSE2__)
+#define BLOCK 16
+#define STRIDE 1
+static uint64_t jsonw_strmask(char *block, char also) {
+  __m128i v = _mm_loadu_si128((__m128i *)block);
+  __m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v);
+  __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+  __m128i bslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+  __m128i other = _mm_cmpeq_epi8(v, _mm_set1_epi8(also));
+  return _mm_movemask_epi8(
+      _mm_or_si128(_mm_or_si128(ctrl, other), _mm_or_si128(quote, bslash)));
+}
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+#define BLOCK 16
+#define STRIDE 4 // NEON has no movemask; narrowing leaves a nibble per byte
+static uint64_t jsonw_strmask(char *block, char also) {
+  uint8x16_t v = vld1q_u8((uint8_t *)block);
+  uint8x16_t ctrl = vcltq_u8(v, vdupq_n_u8(' '));
+  uint8x16_t quote = vceqq_u8(v, vdupq_n_u8('"'));
+  uint8x16_t bslash = vceqq_u8(v, vdupq_n_u8('\\'));
+  uint8x16_t other = vceqq_u8(v, vdupq_n_u8(also));
+  uint8x16_t m = vorrq_u8(vorrq_u8(ctrl, other), vorrq_u8(quote, bslash));
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+#endif
+
+// returns a pointer to the first '"', '\\', `also` or control character at or
+// after `json`, or `end` or `limit`, whichever comes first, if there is none
+// before them. `limit` may be `NULL`. without an `end`, blocks are loaded from
+// aligned addresses so that reading past the terminating NUL never crosses
+// into another page, whatever the limit
+static char *jsonw_scanrun(char *end, char *limit, char also, char *json) {
+  if (end && (limit == NULL || limit > end))
+    limit = end; // from here on, runs stop at `limit` only
+#ifdef BLOCK
+  uint64_t mask;
+  if (end) {
+    for (; limit - json >= BLOCK; json += BLOCK)
+      if (mask = jsonw_strmask(json, also))
+        return json + __builtin_ctzll(mask) / STRIDE;
+  } else {
+    char *block = (char *)((uintptr_t)json & ~(uintptr_t)(BLOCK - 1));
+    if (mask = jsonw_strmask(block, also) >> (json - block) * STRIDE)
+      json += __builtin_ctzll(mask) / STRIDE;
+    else {
+      do
+        block += BLOCK;
+      while ((limit == NULL || block < limit) &&
+             (mask = jsonw_strmask(block, also)) == 0);
+      json = mask ? block + __builtin_ctzll(mask) / STRIDE : limit;
+    }
+    return limit && json > limit ? limit : json;
+  }
+#else
+  // SWAR fallback: test a word at a time for a byte that is less than ' ' or
+  // that equals '"', '\\' or `also`, then find that byte with a bytewise loop
+#define ONES (~(uint64_t)0 / 0xff)
+#define LESS(W, N) (((W) - ONES * (N)) & ~(W) & ONES * 0x80)
+  for (; end == NULL && (uintptr_t)json % sizeof(uint64_t) && json != limit;
+       json++)
+    if (STR_STOP(*json) || *json == also)
+      return json;
+  for (; end ? limit - json >= sizeof(uint64_t) : !limit || json < limit;
+       json += sizeof(uint64_t)) {
+    uint64_t w;
+    memcpy(&w, json, sizeof(w));
+    if (LESS(w, ' ') | LESS(w ^ ONES * '"', 1) | LESS(w ^ ONES * '\\', 1) |
+        LESS(w ^ ONES * (unsigned char)also, 1))
+      break;
+  }
+  if (limit && json > limit)
+    return limit;
+#undef LESS
+#undef ONES
+#endif
+  while (json != limit && !STR_STOP(*json) && *json != also)
+    json++;
+  return json;
+}
+
+// returns a pointer to the first '"', '\\' or control character at or after
+// `json`, or `end` if there is none before it
+static char *jsonw_scanstr(char *end, char *json) {
+  return jsonw_scanrun(end, NULL, '"', json);
+}
+
+#undef BLOCK
+#undef STRIDE
+
+// utf-8 validation
+
+#if defined(__GNUC__) && (defined(__SSSE3__) ||                                \
+                          defined(__ARM_NEON) && defined(__aarch64__))
+#define UTF8_SIMD
+// Keiser and Lemire's lookup tables, indexed by the high nibble of a byte,
+// the low nibble of that byte, and the high nibble of the byte after it. the
+// bits of the entries are the errors a pair of bytes may be part of
+#define TOO_SHORT (1 << 0)  // 11______ 0_______, 11______ 11______
+#define TOO_LONG (1 << 1)   // 0_______ 10______
+#define OVERLONG_3 (1 << 2) // 11100000 100_____
+#define TOO_LARGE (1 << 3)  // 11110100 1001____, 11110101+ 10______
+#define SURROGATE (1 << 4)  // 11101101 101_____
+#define OVERLONG_2 (1 << 5) // 1100000_ 10______
+#define TOO_LARGE_1000 (1 << 6) // 11110101+ 1000____
+#define OVERLONG_4 (1 << 6)     // 11110000 1000____
+#define TWO_CONTS (1 << 7)      // 10______ 10______
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+#define LARGE (CARRY | TOO_LARGE | TOO_LARGE_1000)
+#define CONT (TOO_LONG | OVERLONG_2 | TWO_CONTS)
+static const uint8_t jsonw_utf8tables[3][16] = {
+    {TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+     TOO_LONG, TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+     TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+     TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4},
+    {CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY,
+     CARRY, CARRY | TOO_LARGE, LARGE, LARGE, LARGE, LARGE, LARGE, LARGE, LARGE,
+     LARGE, LARGE | SURROGATE, LARGE, LARGE},
+    {TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+     TOO_SHORT, TOO_SHORT, CONT | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+     CONT | OVERLONG_3 | TOO_LARGE, CONT | SURROGATE | TOO_LARGE,
+     CONT | SURROGATE | TOO_LARGE, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT},
+};
+#undef CONT
+#undef LARGE
+#undef CARRY
+#undef TWO_CONTS
+#undef OVERLONG_4
+#undef TOO_LARGE_1000
+#undef OVERLONG_2
+#undef SURROGATE
+#undef TOO_LARGE
+#undef OVERLONG_3
+#undef TOO_LONG
+#undef TOO_SHORT
+#endif
+
+#if defined(__GNUC__) && defined(__SSSE3__)
+#define VEC __m128i
+#define VEC_LOAD(P) _mm_loadu_si128((__m128i *)(P))
+#define VEC_ZERO _mm_setzero_si128()
+#define VEC_OR _mm_or_si128
+#define VEC_HIGH(V) (_mm_movemask_epi8(V) != 0) // any byte beyond ASCII
+#define VEC_ANY(V) (_mm_movemask_epi8(_mm_cmpeq_epi8(V, VEC_ZERO)) != 0xffff)
+// the errors of the 16 bytes of `in`, paired with the bytes before them
+static __m128i jsonw_utf8err(__m128i in, __m128i prev) {
+  __m128i nibble = _mm_set1_epi8(0x0f);
+  __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+  __m128i prev2 = _mm_alignr_epi8(in, prev, 14);
+  __m128i prev3 = _mm_alignr_epi8(in, prev, 13);
+  __m128i byte1_hi = _mm_shuffle_epi8(
+      VEC_LOAD(jsonw_utf8tables[0]),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte1_lo = _mm_shuffle_epi8(VEC_LOAD(jsonw_utf8tables[1]),
+                                      _mm_and_si128(prev1, nibble));
+  __m128i byte2_hi =
+      _mm_shuffle_epi8(VEC_LOAD(jsonw_utf8tables[2]),
+                       _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+  __m128i special = _mm_and_si128(_mm_and_si128(byte1_hi, byte1_lo), byte2_hi);
+  // the third and fourth bytes of sequences must be continuations
+  __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0x60)),
+                                _mm_subs_epu8(prev3, _mm_set1_epi8(0x70)));
+  return _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8(-0x80)), special);
+}
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+#define VEC uint8x16_t
+#define VEC_LOAD(P) vld1q_u8((uint8_t *)(P))
+#define VEC_ZERO vdupq_n_u8(0)
+#define VEC_OR vorrq_u8
+#define VEC_HIGH(V) (vmaxvq_u8(V) >= 0x80)
+#define VEC_ANY(V) (vmaxvq_u8(V) != 0)
+static uint8x16_t jsonw_utf8err(uint8x16_t in, uint8x16_t prev) {
+  uint8x16_t prev1 = vextq_u8(prev, in, 15), prev2 = vextq_u8(prev, in, 14);
+  uint8x16_t prev3 = vextq_u8(prev, in, 13);
+  uint8x16_t byte1_hi =
+      vqtbl1q_u8(VEC_LOAD(jsonw_utf8tables[0]), vshrq_n_u8(prev1, 4));
+  uint8x16_t byte1_lo = vqtbl1q_u8(VEC_LOAD(jsonw_utf8tables[1]),
+                                   vandq_u8(prev1, vdupq_n_u8(0x0f)));
+  uint8x16_t byte2_hi =
+      vqtbl1q_u8(VEC_LOAD(jsonw_utf8tables[2]), vshrq_n_u8(in, 4));
+  uint8x16_t special = vandq_u8(vandq_u8(byte1_hi, byte1_lo), byte2_hi);
+  uint8x16_t must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0x60)),
+                               vqsubq_u8(prev3, vdupq_n_u8(0x70)));
+  return veorq_u8(vandq_u8(must23, vdupq_n_u8(0x80)), special);
+}
+#endif
+
+#if !defined(UTF8_SIMD) || defined(JSONW_VALIDATE_UTF8)
+// the number of continuation bytes the byte `lead` starts a sequence of, or -1
+// if it starts none, and the range of the first of them
+static int jsonw_utf8lead(unsigned char *lo, unsigned char *hi,
+                          unsigned char lead) {
+  *lo = 0x80, *hi = 0xbf;
+  if (lead < 0x80)
+    return 0;
+  if (lead >= 0xc2 && lead <= 0xdf)
+    return 1;
+  if (lead >= 0xe0 && lead <= 0xef)
+    return *lo = lead == 0xe0 ? 0xa0 : 0x80, *hi = lead == 0xed ? 0x9f : 0xbf,
+           2;
+  if (lead >= 0xf0 && lead <= 0xf4)
+    return *lo = lead == 0xf0 ? 0x90 : 0x80, *hi = lead == 0xf4 ? 0x8f : 0xbf,
+           3;
+  return -1;
+}
+
+// validates a byte at a time. `seq` holds the number of continuation bytes
+// still needed by the sequence cut short by `end`, and the range of the next
+// one, for the next call to resume with
+static bool jsonw_utf8seq(unsigned char seq[3], char *end, char *json) {
+  for (; json != end; json++) {
+    unsigned char chr = *json;
+    int need;
+    if (seq[0] && (chr < seq[1] || chr > seq[2]))
+      return false;
+    if (seq[0])
+      seq[0]--, seq[1] = 0x80, seq[2] = 0xbf;
+    else if ((need = jsonw_utf8lead(seq + 1, seq + 2, chr)) < 0)
+      return false;
+    else
+      seq[0] = need;
+  }
+  return true;
+}
+#endif
+
+char *jsonw_utf8_n(char *end, char *json) {
+  if (json == NULL)
+    return NULL;
+  if (end == NULL)
+    end = json + strlen(json);
+
+#ifdef UTF8_SIMD
+  // the last block is padded with NULs, which sequences cut short by `end`
+  // are invalid before
+  VEC prev = VEC_ZERO, err = VEC_ZERO, in;
+  for (char *block = json, pad[16];; block += 16, prev = in) {
+    if (end - block < 16)
+      memset(pad, 0, 16), memcpy(pad, block, end - block), in = VEC_LOAD(pad);
+    else
+      in = VEC_LOAD(block);
+    // no sequence starts or ends in ASCII following ASCII
+    if (VEC_HIGH(VEC_OR(prev, in)))
+      err = VEC_OR(err, jsonw_utf8err(in, prev));
+    if (end - block < 16)
+      break;
+  }
+  return VEC_ANY(err) ? NULL : end;
+#else
+  // skip ASCII a word at a time between sequences
+  unsigned char seq[3] = {0};
+  for (uint64_t w; json != end;)
+    if (seq[0] == 0 && end - json >= sizeof(w) &&
+        (memcpy(&w, json, sizeof(w)), (w & ~(uint64_t)0 / 0xff * 0x80) == 0))
+      json += sizeof(w);
+    else if (jsonw_utf8seq(seq, json + 1, json))
+      json++;
+    else
+      return NULL;
+  return seq[0] ? NULL : end;
+#endif
+}
+
+#ifdef JSONW_VALIDATE_UTF8
+// validates the chunk from `json` to `end` of a run of characters that's cut
+// short. `seq` is as in `jsonw_utf8seq`
+static bool jsonw_utf8resume(unsigned char seq[3], char *end, char *json) {
+  char *cut = end;
+  for (; seq[0] && json != end; json++)
+    if (!jsonw_utf8seq(seq, json + 1, json))
+      return false;
+  // find the sequence cut short by `end`, if any
+  for (int i = 1; i <= 3 && end - i >= json; i++) {
+    unsigned char lo, hi, chr = end[-i];
+    if ((chr & 0xc0) == 0x80)
+      continue;
+    if (jsonw_utf8lead(&lo, &hi, chr) >= i)
+      cut = end - i;
+    break;
+  }
+  return jsonw_utf8_n(cut, json) && jsonw_utf8seq(seq, end, cut);
+}
+#endif
+
+#undef VEC_ANY
+#undef VEC_HIGH
+#undef VEC_OR
+#undef VEC_ZERO
+#undef VEC_LOAD
+#undef VEC
+#undef UTF8_SIMD
+
 // values, texts
 
-char *jsonw_null(char *json) { return jsonw_litstr("null", json); }
+char *jsonw_null_n(char *end, char *json) {
+  STAT_CALL(NULL, json);
+  return STAT_OK(NULL, jsonw_litstr_n("null", end, json));
+}
 
-char *jsonw_boolean(bool *b, char *json) {
+char *jsonw_boolean_n(bool *b, char *end, char *json) {
   OUT_PARAM(bool, b);
+  STAT_CALL(BOOLEAN, json);
   char *j;
-  (j = jsonw_litstr("true", json)) && (*b = true) ||
-      (j = jsonw_litstr("false", json)) && (*b = false, 1);
-  return j;
+  (j = jsonw_litstr_n("true", end, json)) && (*b = true) ||
+      (j = jsonw_litstr_n("false", end, json)) && (*b = false, 1);
+  return STAT_OK(BOOLEAN, j);
 }
 
-char *jsonw_number(double *num, char *json) {
+#define ISDIGIT(CHR) ((unsigned)(CHR) - '0' < 10)
+
+// accumulates up to `max` digits from `json` into `w`, eight at a time where
+// possible. without an `end`, eight bytes are only loaded when they don't
+// straddle a page, so reading past the terminating NUL is harmless
+static char *jsonw_digits(uint64_t *w, int max, char *end, char *json) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (uint64_t x; max >= 8 && (end ? end - json >= 8
+                                    : (uintptr_t)json % 4096 <= 4096 - 8);
+       json += 8, max -= 8) {
+    memcpy(&x, json, sizeof(x));
+    // every byte is in ['0', '9'] iff its high nibble is 3 both before and
+    // after adding 6
+    if ((x & 0xf0f0f0f0f0f0f0f0) != 0x3030303030303030 ||
+        (x + 0x0606060606060606 & 0xf0f0f0f0f0f0f0f0) != 0x3030303030303030)
+      break;
+    // combine adjacent digits into pairs, then pairs into fours, and so on
+    x -= 0x3030303030303030;
+    x = x * 10 + (x >> 8);
+    x = ((x & 0x000000ff000000ff) * (100 + (1000000ULL << 32)) +
+         (x >> 16 & 0x000000ff000000ff) * (1 + (10000ULL << 32))) >>
+        32;
+    *w = *w * 100000000 + (uint32_t)x;
+  }
+#endif
+  for (; max > 0 && ISDIGIT(AT(json)); json++, max--)
+    *w = *w * 10 + (*json - '0');
+  return json;
+}
+
+// powers of ten that are exactly representable by `double`s
+static const double jsonw_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 128-bit truncations of 5^q for q in [-342, 324], shifted so that their most
+// significant bit is set. for q < 0 these approximate 1 / 5^-q, rounded up.
+// parsing needs q up to 308 and formatting subnormal numbers up to 324
+static const uint64_t jsonw_pow5[][2] = {
+    {0xeef453d6923bd65a, 0x113faa2906a13b3f},
+    {0x9558b4661b6565f8, 0x4ac7ca59a424c507},
+    {0xbaaee17fa23ebf76, 0x5d79bcf00d2df649},
+    {0xe95a99df8ace6f53, 0xf4d82c2c107973dc},
+    {0x91d8a02bb6c10594, 0x79071b9b8a4be869},
+    {0xb64ec836a47146f9, 0x9748e2826cdee284},
+    {0xe3e27a444d8d98b7, 0xfd1b1b2308169b25},
+    {0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7},
+    {0xb208ef855c969f4f, 0xbdbd2d335e51a935},
+    {0xde8b2b66b3bc4723, 0xad2c788035e61382},
+    {0x8b16fb203055ac76, 0x4c3bcb5021afcc31},
+    {0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d},
+    {0xd953e8624b85dd78, 0xd71d6dad34a2af0d},
+    {0x87d4713d6f33aa6b, 0x8672648c40e5ad68},
+    {0xa9c98d8ccb009506, 0x680efdaf511f18c2},
+    {0xd43bf0effdc0ba48, 0x0212bd1b2566def2},
+    {0x84a57695fe98746d, 0x014bb630f7604b57},
+    {0xa5ced43b7e3e9188, 0x419ea3bd35385e2d},
+    {0xcf42894a5dce35ea, 0x52064cac828675b9},
+    {0x818995ce7aa0e1b2, 0x7343efebd1940993},
+    {0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8},
+    {0xca66fa129f9b60a6, 0xd41a26e077774ef6},
+    {0xfd00b897478238d0, 0x8920b098955522b4},
+    {0x9e20735e8cb16382, 0x55b46e5f5d5535b0},
+    {0xc5a890362fddbc62, 0xeb2189f734aa831d},
+    {0xf712b443bbd52b7b, 0xa5e9ec7501d523e4},
+    {0x9a6bb0aa55653b2d, 0x47b233c92125366e},
+    {0xc1069cd4eabe89f8, 0x999ec0bb696e840a},
+    {0xf148440a256e2c76, 0xc00670ea43ca250d},
+    {0x96cd2a865764dbca, 0x380406926a5e5728},
+    {0xbc807527ed3e12bc, 0xc605083704f5ecf2},
+    {0xeba09271e88d976b, 0xf7864a44c633682e},
+    {0x93445b8731587ea3, 0x7ab3ee6afbe0211d},
+    {0xb8157268fdae9e4c, 0x5960ea05bad82964},
+    {0xe61acf033d1a45df, 0x6fb92487298e33bd},
+    {0x8fd0c16206306bab, 0xa5d3b6d479f8e056},
+    {0xb3c4f1ba87bc8696, 0x8f48a4899877186c},
+    {0xe0b62e2929aba83c, 0x331acdabfe94de87},
+    {0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14},
+    {0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9},
+    {0xdb71e91432b1a24a, 0xc9e82cd9f69d6150},
+    {0x892731ac9faf056e, 0xbe311c083a225cd2},
+    {0xab70fe17c79ac6ca, 0x6dbd630a48aaf406},
+    {0xd64d3d9db981787d, 0x092cbbccdad5b108},
+    {0x85f0468293f0eb4e, 0x25bbf56008c58ea5},
+    {0xa76c582338ed2621, 0xaf2af2b80af6f24e},
+    {0xd1476e2c07286faa, 0x1af5af660db4aee1},
+    {0x82cca4db847945ca, 0x50d98d9fc890ed4d},
+    {0xa37fce126597973c, 0xe50ff107bab528a0},
+    {0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8},
+    {0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a},
+    {0x9faacf3df73609b1, 0x77b191618c54e9ac},
+    {0xc795830d75038c1d, 0xd59df5b9ef6a2417},
+    {0xf97ae3d0d2446f25, 0x4b0573286b44ad1d},
+    {0x9becce62836ac577, 0x4ee367f9430aec32},
+    {0xc2e801fb244576d5, 0x229c41f793cda73f},
+    {0xf3a20279ed56d48a, 0x6b43527578c1110f},
+    {0x9845418c345644d6, 0x830a13896b78aaa9},
+    {0xbe5691ef416bd60c, 0x23cc986bc656d553},
+    {0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8},
+    {0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9},
+    {0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53},
+    {0xe858ad248f5c22c9, 0xd1b3400f8f9cff68},
+    {0x91376c36d99995be, 0x23100809b9c21fa1},
+    {0xb58547448ffffb2d, 0xabd40a0c2832a78a},
+    {0xe2e69915b3fff9f9, 0x16c90c8f323f516c},
+    {0x8dd01fad907ffc3b, 0xae3da7d97f6792e3},
+    {0xb1442798f49ffb4a, 0x99cd11cfdf41779c},
+    {0xdd95317f31c7fa1d, 0x40405643d711d583},
+    {0x8a7d3eef7f1cfc52, 0x482835ea666b2572},
+    {0xad1c8eab5ee43b66, 0xda3243650005eecf},
+    {0xd863b256369d4a40, 0x90bed43e40076a82},
+    {0x873e4f75e2224e68, 0x5a7744a6e804a291},
+    {0xa90de3535aaae202, 0x711515d0a205cb36},
+    {0xd3515c2831559a83, 0x0d5a5b44ca873e03},
+    {0x8412d9991ed58091, 0xe858790afe9486c2},
+    {0xa5178fff668ae0b6, 0x626e974dbe39a872},
+    {0xce5d73ff402d98e3, 0xfb0a3d212dc8128f},
+    {0x80fa687f881c7f8e, 0x7ce66634bc9d0b99},
+    {0xa139029f6a239f72, 0x1c1fffc1ebc44e80},
+    {0xc987434744ac874e, 0xa327ffb266b56220},
+    {0xfbe9141915d7a922, 0x4bf1ff9f0062baa8},
+    {0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9},
+    {0xc4ce17b399107c22, 0xcb550fb4384d21d3},
+    {0xf6019da07f549b2b, 0x7e2a53a146606a48},
+    {0x99c102844f94e0fb, 0x2eda7444cbfc426d},
+    {0xc0314325637a1939, 0xfa911155fefb5308},
+    {0xf03d93eebc589f88, 0x793555ab7eba27ca},
+    {0x96267c7535b763b5, 0x4bc1558b2f3458de},
+    {0xbbb01b9283253ca2, 0x9eb1aaedfb016f16},
+    {0xea9c227723ee8bcb, 0x465e15a979c1cadc},
+    {0x92a1958a7675175f, 0x0bfacd89ec191ec9},
+    {0xb749faed14125d36, 0xcef980ec671f667b},
+    {0xe51c79a85916f484, 0x82b7e12780e7401a},
+    {0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810},
+    {0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15},
+    {0xdfbdcece67006ac9, 0x67a791e093e1d49a},
+    {0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0},
+    {0xaecc49914078536d, 0x58fae9f773886e18},
+    {0xda7f5bf590966848, 0xaf39a475506a899e},
+    {0x888f99797a5e012d, 0x6d8406c952429603},
+    {0xaab37fd7d8f58178, 0xc8e5087ba6d33b83},
+    {0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64},
+    {0x855c3be0a17fcd26, 0x5cf2eea09a55067f},
+    {0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e},
+    {0xd0601d8efc57b08b, 0xf13b94daf124da26},
+    {0x823c12795db6ce57, 0x76c53d08d6b70858},
+    {0xa2cb1717b52481ed, 0x54768c4b0c64ca6e},
+    {0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09},
+    {0xfe5d54150b090b02, 0xd3f93b35435d7c4c},
+    {0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf},
+    {0xc6b8e9b0709f109a, 0x359ab6419ca1091b},
+    {0xf867241c8cc6d4c0, 0xc30163d203c94b62},
+    {0x9b407691d7fc44f8, 0x79e0de63425dcf1d},
+    {0xc21094364dfb5636, 0x985915fc12f542e4},
+    {0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d},
+    {0x979cf3ca6cec5b5a, 0xa705992ceecf9c42},
+    {0xbd8430bd08277231, 0x50c6ff782a838353},
+    {0xece53cec4a314ebd, 0xa4f8bf5635246428},
+    {0x940f4613ae5ed136, 0x871b7795e136be99},
+    {0xb913179899f68584, 0x28e2557b59846e3f},
+    {0xe757dd7ec07426e5, 0x331aeada2fe589cf},
+    {0x9096ea6f3848984f, 0x3ff0d2c85def7621},
+    {0xb4bca50b065abe63, 0x0fed077a756b53a9},
+    {0xe1ebce4dc7f16dfb, 0xd3e8495912c62894},
+    {0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c},
+    {0xb080392cc4349dec, 0xbd8d794d96aacfb3},
+    {0xdca04777f541c567, 0xecf0d7a0fc5583a0},
+    {0x89e42caaf9491b60, 0xf41686c49db57244},
+    {0xac5d37d5b79b6239, 0x311c2875c522ced5},
+    {0xd77485cb25823ac7, 0x7d633293366b828b},
+    {0x86a8d39ef77164bc, 0xae5dff9c02033197},
+    {0xa8530886b54dbdeb, 0xd9f57f830283fdfc},
+    {0xd267caa862a12d66, 0xd072df63c324fd7b},
+    {0x8380dea93da4bc60, 0x4247cb9e59f71e6d},
+    {0xa46116538d0deb78, 0x52d9be85f074e608},
+    {0xcd795be870516656, 0x67902e276c921f8b},
+    {0x806bd9714632dff6, 0x00ba1cd8a3db53b6},
+    {0xa086cfcd97bf97f3, 0x80e8a40eccd228a4},
+    {0xc8a883c0fdaf7df0, 0x6122cd128006b2cd},
+    {0xfad2a4b13d1b5d6c, 0x796b805720085f81},
+    {0x9cc3a6eec6311a63, 0xcbe3303674053bb0},
+    {0xc3f490aa77bd60fc, 0xbedbfc4411068a9c},
+    {0xf4f1b4d515acb93b, 0xee92fb5515482d44},
+    {0x991711052d8bf3c5, 0x751bdd152d4d1c4a},
+    {0xbf5cd54678eef0b6, 0xd262d45a78a0635d},
+    {0xef340a98172aace4, 0x86fb897116c87c34},
+    {0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0},
+    {0xbae0a846d2195712, 0x8974836059cca109},
+    {0xe998d258869facd7, 0x2bd1a438703fc94b},
+    {0x91ff83775423cc06, 0x7b6306a34627ddcf},
+    {0xb67f6455292cbf08, 0x1a3bc84c17b1d542},
+    {0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93},
+    {0x8e938662882af53e, 0x547eb47b7282ee9c},
+    {0xb23867fb2a35b28d, 0xe99e619a4f23aa43},
+    {0xdec681f9f4c31f31, 0x6405fa00e2ec94d4},
+    {0x8b3c113c38f9f37e, 0xde83bc408dd3dd04},
+    {0xae0b158b4738705e, 0x9624ab50b148d445},
+    {0xd98ddaee19068c76, 0x3badd624dd9b0957},
+    {0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6},
+    {0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c},
+    {0xd47487cc8470652b, 0x7647c3200069671f},
+    {0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073},
+    {0xa5fb0a17c777cf09, 0xf468107100525890},
+    {0xcf79cc9db955c2cc, 0x7182148d4066eeb4},
+    {0x81ac1fe293d599bf, 0xc6f14cd848405530},
+    {0xa21727db38cb002f, 0xb8ada00e5a506a7c},
+    {0xca9cf1d206fdc03b, 0xa6d90811f0e4851c},
+    {0xfd442e4688bd304a, 0x908f4a166d1da663},
+    {0x9e4a9cec15763e2e, 0x9a598e4e043287fe},
+    {0xc5dd44271ad3cdba, 0x40eff1e1853f29fd},
+    {0xf7549530e188c128, 0xd12bee59e68ef47c},
+    {0x9a94dd3e8cf578b9, 0x82bb74f8301958ce},
+    {0xc13a148e3032d6e7, 0xe36a52363c1faf01},
+    {0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1},
+    {0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9},
+    {0xbcb2b812db11a5de, 0x7415d448f6b6f0e7},
+    {0xebdf661791d60f56, 0x111b495b3464ad21},
+    {0x936b9fcebb25c995, 0xcab10dd900beec34},
+    {0xb84687c269ef3bfb, 0x3d5d514f40eea742},
+    {0xe65829b3046b0afa, 0x0cb4a5a3112a5112},
+    {0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab},
+    {0xb3f4e093db73a093, 0x59ed216765690f56},
+    {0xe0f218b8d25088b8, 0x306869c13ec3532c},
+    {0x8c974f7383725573, 0x1e414218c73a13fb},
+    {0xafbd2350644eeacf, 0xe5d1929ef90898fa},
+    {0xdbac6c247d62a583, 0xdf45f746b74abf39},
+    {0x894bc396ce5da772, 0x6b8bba8c328eb783},
+    {0xab9eb47c81f5114f, 0x066ea92f3f326564},
+    {0xd686619ba27255a2, 0xc80a537b0efefebd},
+    {0x8613fd0145877585, 0xbd06742ce95f5f36},
+    {0xa798fc4196e952e7, 0x2c48113823b73704},
+    {0xd17f3b51fca3a7a0, 0xf75a15862ca504c5},
+    {0x82ef85133de648c4, 0x9a984d73dbe722fb},
+    {0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba},
+    {0xcc963fee10b7d1b3, 0x318df905079926a8},
+    {0xffbbcfe994e5c61f, 0xfdf17746497f7052},
+    {0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633},
+    {0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0},
+    {0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0},
+    {0x9c1661a651213e2d, 0x06bea10ca65c084e},
+    {0xc31bfa0fe5698db8, 0x486e494fcff30a62},
+    {0xf3e2f893dec3f126, 0x5a89dba3c3efccfa},
+    {0x986ddb5c6b3a76b7, 0xf89629465a75e01c},
+    {0xbe89523386091465, 0xf6bbb397f1135823},
+    {0xee2ba6c0678b597f, 0x746aa07ded582e2c},
+    {0x94db483840b717ef, 0xa8c2a44eb4571cdc},
+    {0xba121a4650e4ddeb, 0x92f34d62616ce413},
+    {0xe896a0d7e51e1566, 0x77b020baf9c81d17},
+    {0x915e2486ef32cd60, 0x0ace1474dc1d122e},
+    {0xb5b5ada8aaff80b8, 0x0d819992132456ba},
+    {0xe3231912d5bf60e6, 0x10e1fff697ed6c69},
+    {0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1},
+    {0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2},
+    {0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde},
+    {0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b},
+    {0xad4ab7112eb3929d, 0x86c16c98d2c953c6},
+    {0xd89d64d57a607744, 0xe871c7bf077ba8b7},
+    {0x87625f056c7c4a8b, 0x11471cd764ad4972},
+    {0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf},
+    {0xd389b47879823479, 0x4aff1d108d4ec2c3},
+    {0x843610cb4bf160cb, 0xcedf722a585139ba},
+    {0xa54394fe1eedb8fe, 0xc2974eb4ee658828},
+    {0xce947a3da6a9273e, 0x733d226229feea32},
+    {0x811ccc668829b887, 0x0806357d5a3f525f},
+    {0xa163ff802a3426a8, 0xca07c2dcb0cf26f7},
+    {0xc9bcff6034c13052, 0xfc89b393dd02f0b5},
+    {0xfc2c3f3841f17c67, 0xbbac2078d443ace2},
+    {0x9d9ba7832936edc0, 0xd54b944b84aa4c0d},
+    {0xc5029163f384a931, 0x0a9e795e65d4df11},
+    {0xf64335bcf065d37d, 0x4d4617b5ff4a16d5},
+    {0x99ea0196163fa42e, 0x504bced1bf8e4e45},
+    {0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6},
+    {0xf07da27a82c37088, 0x5d767327bb4e5a4c},
+    {0x964e858c91ba2655, 0x3a6a07f8d510f86f},
+    {0xbbe226efb628afea, 0x890489f70a55368b},
+    {0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e},
+    {0x92c8ae6b464fc96f, 0x3b0b8bc90012929d},
+    {0xb77ada0617e3bbcb, 0x09ce6ebb40173744},
+    {0xe55990879ddcaabd, 0xcc420a6a101d0515},
+    {0x8f57fa54c2a9eab6, 0x9fa946824a12232d},
+    {0xb32df8e9f3546564, 0x47939822dc96abf9},
+    {0xdff9772470297ebd, 0x59787e2b93bc56f7},
+    {0x8bfbea76c619ef36, 0x57eb4edb3c55b65a},
+    {0xaefae51477a06b03, 0xede622920b6b23f1},
+    {0xdab99e59958885c4, 0xe95fab368e45eced},
+    {0x88b402f7fd75539b, 0x11dbcb0218ebb414},
+    {0xaae103b5fcd2a881, 0xd652bdc29f26a119},
+    {0xd59944a37c0752a2, 0x4be76d3346f0495f},
+    {0x857fcae62d8493a5, 0x6f70a4400c562ddb},
+    {0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952},
+    {0xd097ad07a71f26b2, 0x7e2000a41346a7a7},
+    {0x825ecc24c873782f, 0x8ed400668c0c28c8},
+    {0xa2f67f2dfa90563b, 0x728900802f0f32fa},
+    {0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9},
+    {0xfea126b7d78186bc, 0xe2f610c84987bfa8},
+    {0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9},
+    {0xc6ede63fa05d3143, 0x91503d1c79720dbb},
+    {0xf8a95fcf88747d94, 0x75a44c6397ce912a},
+    {0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba},
+    {0xc24452da229b021b, 0xfbe85badce996168},
+    {0xf2d56790ab41c2a2, 0xfae27299423fb9c3},
+    {0x97c560ba6b0919a5, 0xdccd879fc967d41a},
+    {0xbdb6b8e905cb600f, 0x5400e987bbc1c920},
+    {0xed246723473e3813, 0x290123e9aab23b68},
+    {0x9436c0760c86e30b, 0xf9a0b6720aaf6521},
+    {0xb94470938fa89bce, 0xf808e40e8d5b3e69},
+    {0xe7958cb87392c2c2, 0xb60b1d1230b20e04},
+    {0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2},
+    {0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3},
+    {0xe2280b6c20dd5232, 0x25c6da63c38de1b0},
+    {0x8d590723948a535f, 0x579c487e5a38ad0e},
+    {0xb0af48ec79ace837, 0x2d835a9df0c6d851},
+    {0xdcdb1b2798182244, 0xf8e431456cf88e65},
+    {0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff},
+    {0xac8b2d36eed2dac5, 0xe272467e3d222f3f},
+    {0xd7adf884aa879177, 0x5b0ed81dcc6abb0f},
+    {0x86ccbb52ea94baea, 0x98e947129fc2b4e9},
+    {0xa87fea27a539e9a5, 0x3f2398d747b36224},
+    {0xd29fe4b18e88640e, 0x8eec7f0d19a03aad},
+    {0x83a3eeeef9153e89, 0x1953cf68300424ac},
+    {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7},
+    {0xcdb02555653131b6, 0x3792f412cb06794d},
+    {0x808e17555f3ebf11, 0xe2bbd88bbee40bd0},
+    {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4},
+    {0xc8de047564d20a8b, 0xf245825a5a445275},
+    {0xfb158592be068d2e, 0xeed6e2f0f0d56712},
+    {0x9ced737bb6c4183d, 0x55464dd69685606b},
+    {0xc428d05aa4751e4c, 0xaa97e14c3c26b886},
+    {0xf53304714d9265df, 0xd53dd99f4b3066a8},
+    {0x993fe2c6d07b7fab, 0xe546a8038efe4029},
+    {0xbf8fdb78849a5f96, 0xde98520472bdd033},
+    {0xef73d256a5c0f77c, 0x963e66858f6d4440},
+    {0x95a8637627989aad, 0xdde7001379a44aa8},
+    {0xbb127c53b17ec159, 0x5560c018580d5d52},
+    {0xe9d71b689dde71af, 0xaab8f01e6e10b4a6},
+    {0x9226712162ab070d, 0xcab3961304ca70e8},
+    {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22},
+    {0xe45c10c42a2b3b05, 0x8cb89a7db77c506a},
+    {0x8eb98a7a9a5b04e3, 0x77f3608e92adb242},
+    {0xb267ed1940f1c61c, 0x55f038b237591ed3},
+    {0xdf01e85f912e37a3, 0x6b6c46dec52f6688},
+    {0x8b61313bbabce2c6, 0x2323ac4b3b3da015},
+    {0xae397d8aa96c1b77, 0xabec975e0a0d081a},
+    {0xd9c7dced53c72255, 0x96e7bd358c904a21},
+    {0x881cea14545c7575, 0x7e50d64177da2e54},
+    {0xaa242499697392d2, 0xdde50bd1d5d0b9e9},
+    {0xd4ad2dbfc3d07787, 0x955e4ec64b44e864},
+    {0x84ec3c97da624ab4, 0xbd5af13bef0b113e},
+    {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e},
+    {0xcfb11ead453994ba, 0x67de18eda5814af2},
+    {0x81ceb32c4b43fcf4, 0x80eacf948770ced7},
+    {0xa2425ff75e14fc31, 0xa1258379a94d028d},
+    {0xcad2f7f5359a3b3e, 0x096ee45813a04330},
+    {0xfd87b5f28300ca0d, 0x8bca9d6e188853fc},
+    {0x9e74d1b791e07e48, 0x775ea264cf55347e},
+    {0xc612062576589dda, 0x95364afe032a819e},
+    {0xf79687aed3eec551, 0x3a83ddbd83f52205},
+    {0x9abe14cd44753b52, 0xc4926a9672793543},
+    {0xc16d9a0095928a27, 0x75b7053c0f178294},
+    {0xf1c90080baf72cb1, 0x5324c68b12dd6339},
+    {0x971da05074da7bee, 0xd3f6fc16ebca5e04},
+    {0xbce5086492111aea, 0x88f4bb1ca6bcf585},
+    {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6},
+    {0x9392ee8e921d5d07, 0x3aff322e62439fd0},
+    {0xb877aa3236a4b449, 0x09befeb9fad487c3},
+    {0xe69594bec44de15b, 0x4c2ebe687989a9b4},
+    {0x901d7cf73ab0acd9, 0x0f9d37014bf60a11},
+    {0xb424dc35095cd80f, 0x538484c19ef38c95},
+    {0xe12e13424bb40e13, 0x2865a5f206b06fba},
+    {0x8cbccc096f5088cb, 0xf93f87b7442e45d4},
+    {0xafebff0bcb24aafe, 0xf78f69a51539d749},
+    {0xdbe6fecebdedd5be, 0xb573440e5a884d1c},
+    {0x89705f4136b4a597, 0x31680a88f8953031},
+    {0xabcc77118461cefc, 0xfdc20d2b36ba7c3e},
+    {0xd6bf94d5e57a42bc, 0x3d32907604691b4d},
+    {0x8637bd05af6c69b5, 0xa63f9a49c2c1b110},
+    {0xa7c5ac471b478423, 0x0fcf80dc33721d54},
+    {0xd1b71758e219652b, 0xd3c36113404ea4a9},
+    {0x83126e978d4fdf3b, 0x645a1cac083126ea},
+    {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4},
+    {0xcccccccccccccccc, 0xcccccccccccccccd},
+    {0x8000000000000000, 0x0000000000000000},
+    {0xa000000000000000, 0x0000000000000000},
+    {0xc800000000000000, 0x0000000000000000},
+    {0xfa00000000000000, 0x0000000000000000},
+    {0x9c40000000000000, 0x0000000000000000},
+    {0xc350000000000000, 0x0000000000000000},
+    {0xf424000000000000, 0x0000000000000000},
+    {0x9896800000000000, 0x0000000000000000},
+    {0xbebc200000000000, 0x0000000000000000},
+    {0xee6b280000000000, 0x0000000000000000},
+    {0x9502f90000000000, 0x0000000000000000},
+    {0xba43b74000000000, 0x0000000000000000},
+    {0xe8d4a51000000000, 0x0000000000000000},
+    {0x9184e72a00000000, 0x0000000000000000},
+    {0xb5e620f480000000, 0x0000000000000000},
+    {0xe35fa931a0000000, 0x0000000000000000},
+    {0x8e1bc9bf04000000, 0x0000000000000000},
+    {0xb1a2bc2ec5000000, 0x0000000000000000},
+    {0xde0b6b3a76400000, 0x0000000000000000},
+    {0x8ac7230489e80000, 0x0000000000000000},
+    {0xad78ebc5ac620000, 0x0000000000000000},
+    {0xd8d726b7177a8000, 0x0000000000000000},
+    {0x878678326eac9000, 0x0000000000000000},
+    {0xa968163f0a57b400, 0x0000000000000000},
+    {0xd3c21bcecceda100, 0x0000000000000000},
+    {0x84595161401484a0, 0x0000000000000000},
+    {0xa56fa5b99019a5c8, 0x0000000000000000},
+    {0xcecb8f27f4200f3a, 0x0000000000000000},
+    {0x813f3978f8940984, 0x4000000000000000},
+    {0xa18f07d736b90be5, 0x5000000000000000},
+    {0xc9f2c9cd04674ede, 0xa400000000000000},
+    {0xfc6f7c4045812296, 0x4d00000000000000},
+    {0x9dc5ada82b70b59d, 0xf020000000000000},
+    {0xc5371912364ce305, 0x6c28000000000000},
+    {0xf684df56c3e01bc6, 0xc732000000000000},
+    {0x9a130b963a6c115c, 0x3c7f400000000000},
+    {0xc097ce7bc90715b3, 0x4b9f100000000000},
+    {0xf0bdc21abb48db20, 0x1e86d40000000000},
+    {0x96769950b50d88f4, 0x1314448000000000},
+    {0xbc143fa4e250eb31, 0x17d955a000000000},
+    {0xeb194f8e1ae525fd, 0x5dcfab0800000000},
+    {0x92efd1b8d0cf37be, 0x5aa1cae500000000},
+    {0xb7abc627050305ad, 0xf14a3d9e40000000},
+    {0xe596b7b0c643c719, 0x6d9ccd05d0000000},
+    {0x8f7e32ce7bea5c6f, 0xe4820023a2000000},
+    {0xb35dbf821ae4f38b, 0xdda2802c8a800000},
+    {0xe0352f62a19e306e, 0xd50b2037ad200000},
+    {0x8c213d9da502de45, 0x4526f422cc340000},
+    {0xaf298d050e4395d6, 0x9670b12b7f410000},
+    {0xdaf3f04651d47b4c, 0x3c0cdd765f114000},
+    {0x88d8762bf324cd0f, 0xa5880a69fb6ac800},
+    {0xab0e93b6efee0053, 0x8eea0d047a457a00},
+    {0xd5d238a4abe98068, 0x72a4904598d6d880},
+    {0x85a36366eb71f041, 0x47a6da2b7f864750},
+    {0xa70c3c40a64e6c51, 0x999090b65f67d924},
+    {0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},
+    {0x82818f1281ed449f, 0xbff8f10e7a8921a4},
+    {0xa321f2d7226895c7, 0xaff72d52192b6a0d},
+    {0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490},
+    {0xfee50b7025c36a08, 0x02f236d04753d5b4},
+    {0x9f4f2726179a2245, 0x01d762422c946590},
+    {0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5},
+    {0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2},
+    {0x9b934c3b330c8577, 0x63cc55f49f88eb2f},
+    {0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb},
+    {0xf316271c7fc3908a, 0x8bef464e3945ef7a},
+    {0x97edd871cfda3a56, 0x97758bf0e3cbb5ac},
+    {0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317},
+    {0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd},
+    {0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a},
+    {0xb975d6b6ee39e436, 0xb3e2fd538e122b44},
+    {0xe7d34c64a9c85d44, 0x60dbbca87196b616},
+    {0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd},
+    {0xb51d13aea4a488dd, 0x6babab6398bdbe41},
+    {0xe264589a4dcdab14, 0xc696963c7eed2dd1},
+    {0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2},
+    {0xb0de65388cc8ada8, 0x3b25a55f43294bcb},
+    {0xdd15fe86affad912, 0x49ef0eb713f39ebe},
+    {0x8a2dbf142dfcc7ab, 0x6e3569326c784337},
+    {0xacb92ed9397bf996, 0x49c2c37f07965404},
+    {0xd7e77a8f87daf7fb, 0xdc33745ec97be906},
+    {0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3},
+    {0xa8acd7c0222311bc, 0xc40832ea0d68ce0c},
+    {0xd2d80db02aabd62b, 0xf50a3fa490c30190},
+    {0x83c7088e1aab65db, 0x792667c6da79e0fa},
+    {0xa4b8cab1a1563f52, 0x577001b891185938},
+    {0xcde6fd5e09abcf26, 0xed4c0226b55e6f86},
+    {0x80b05e5ac60b6178, 0x544f8158315b05b4},
+    {0xa0dc75f1778e39d6, 0x696361ae3db1c721},
+    {0xc913936dd571c84c, 0x03bc3a19cd1e38e9},
+    {0xfb5878494ace3a5f, 0x04ab48a04065c723},
+    {0x9d174b2dcec0e47b, 0x62eb0d64283f9c76},
+    {0xc45d1df942711d9a, 0x3ba5d0bd324f8394},
+    {0xf5746577930d6500, 0xca8f44ec7ee36479},
+    {0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb},
+    {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e},
+    {0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e},
+    {0x95d04aee3b80ece5, 0xbba1f1d158724a12},
+    {0xbb445da9ca61281f, 0x2a8a6e45ae8edc97},
+    {0xea1575143cf97226, 0xf52d09d71a3293bd},
+    {0x924d692ca61be758, 0x593c2626705f9c56},
+    {0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c},
+    {0xe498f455c38b997a, 0x0b6dfb9c0f956447},
+    {0x8edf98b59a373fec, 0x4724bd4189bd5eac},
+    {0xb2977ee300c50fe7, 0x58edec91ec2cb657},
+    {0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed},
+    {0x8b865b215899f46c, 0xbd79e0d20082ee74},
+    {0xae67f1e9aec07187, 0xecd8590680a3aa11},
+    {0xda01ee641a708de9, 0xe80e6f4820cc9495},
+    {0x884134fe908658b2, 0x3109058d147fdcdd},
+    {0xaa51823e34a7eede, 0xbd4b46f0599fd415},
+    {0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a},
+    {0x850fadc09923329e, 0x03e2cf6bc604ddb0},
+    {0xa6539930bf6bff45, 0x84db8346b786151c},
+    {0xcfe87f7cef46ff16, 0xe612641865679a63},
+    {0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e},
+    {0xa26da3999aef7749, 0xe3be5e330f38f09d},
+    {0xcb090c8001ab551c, 0x5cadf5bfd3072cc5},
+    {0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6},
+    {0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa},
+    {0xc646d63501a1511d, 0xb281e1fd541501b8},
+    {0xf7d88bc24209a565, 0x1f225a7ca91a4226},
+    {0x9ae757596946075f, 0x3375788de9b06958},
+    {0xc1a12d2fc3978937, 0x0052d6b1641c83ae},
+    {0xf209787bb47d6b84, 0xc0678c5dbd23a49a},
+    {0x9745eb4d50ce6332, 0xf840b7ba963646e0},
+    {0xbd176620a501fbff, 0xb650e5a93bc3d898},
+    {0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe},
+    {0x93ba47c980e98cdf, 0xc66f336c36b10137},
+    {0xb8a8d9bbe123f017, 0xb80b0047445d4184},
+    {0xe6d3102ad96cec1d, 0xa60dc059157491e5},
+    {0x9043ea1ac7e41392, 0x87c89837ad68db2f},
+    {0xb454e4a179dd1877, 0x29babe4598c311fb},
+    {0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a},
+    {0x8ce2529e2734bb1d, 0x1899e4a65f58660c},
+    {0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f},
+    {0xdc21a1171d42645d, 0x76707543f4fa1f73},
+    {0x899504ae72497eba, 0x6a06494a791c53a8},
+    {0xabfa45da0edbde69, 0x0487db9d17636892},
+    {0xd6f8d7509292d603, 0x45a9d2845d3c42b6},
+    {0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2},
+    {0xa7f26836f282b732, 0x8e6cac7768d7141e},
+    {0xd1ef0244af2364ff, 0x3207d795430cd926},
+    {0x8335616aed761f1f, 0x7f44e6bd49e807b8},
+    {0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6},
+    {0xcd036837130890a1, 0x36dba887c37a8c0f},
+    {0x802221226be55a64, 0xc2494954da2c9789},
+    {0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c},
+    {0xc83553c5c8965d3d, 0x6f92829494e5acc7},
+    {0xfa42a8b73abbf48c, 0xcb772339ba1f17f9},
+    {0x9c69a97284b578d7, 0xff2a760414536efb},
+    {0xc38413cf25e2d70d, 0xfef5138519684aba},
+    {0xf46518c2ef5b8cd1, 0x7eb258665fc25d69},
+    {0x98bf2f79d5993802, 0xef2f773ffbd97a61},
+    {0xbeeefb584aff8603, 0xaafb550ffacfd8fa},
+    {0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38},
+    {0x952ab45cfa97a0b2, 0xdd945a747bf26183},
+    {0xba756174393d88df, 0x94f971119aeef9e4},
+    {0xe912b9d1478ceb17, 0x7a37cd5601aab85d},
+    {0x91abb422ccb812ee, 0xac62e055c10ab33a},
+    {0xb616a12b7fe617aa, 0x577b986b314d6009},
+    {0xe39c49765fdf9d94, 0xed5a7e85fda0b80b},
+    {0x8e41ade9fbebc27d, 0x14588f13be847307},
+    {0xb1d219647ae6b31c, 0x596eb2d8ae258fc8},
+    {0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb},
+    {0x8aec23d680043bee, 0x25de7bb9480d5854},
+    {0xada72ccc20054ae9, 0xaf561aa79a10ae6a},
+    {0xd910f7ff28069da4, 0x1b2ba1518094da04},
+    {0x87aa9aff79042286, 0x90fb44d2f05d0842},
+    {0xa99541bf57452b28, 0x353a1607ac744a53},
+    {0xd3fa922f2d1675f2, 0x42889b8997915ce8},
+    {0x847c9b5d7c2e09b7, 0x69956135febada11},
+    {0xa59bc234db398c25, 0x43fab9837e699095},
+    {0xcf02b2c21207ef2e, 0x94f967e45e03f4bb},
+    {0x8161afb94b44f57d, 0x1d1be0eebac278f5},
+    {0xa1ba1ba79e1632dc, 0x6462d92a69731732},
+    {0xca28a291859bbf93, 0x7d7b8f7503cfdcfe},
+    {0xfcb2cb35e702af78, 0x5cda735244c3d43e},
+    {0x9defbf01b061adab, 0x3a0888136afa64a7},
+    {0xc56baec21c7a1916, 0x088aaa1845b8fdd0},
+    {0xf6c69a72a3989f5b, 0x8aad549e57273d45},
+    {0x9a3c2087a63f6399, 0x36ac54e2f678864b},
+    {0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd},
+    {0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5},
+    {0x969eb7c47859e743, 0x9f644ae5a4b1b325},
+    {0xbc4665b596706114, 0x873d5d9f0dde1fee},
+    {0xeb57ff22fc0c7959, 0xa90cb506d155a7ea},
+    {0x9316ff75dd87cbd8, 0x09a7f12442d588f2},
+    {0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f},
+    {0xe5d3ef282a242e81, 0x8f1668c8a86da5fa},
+    {0x8fa475791a569d10, 0xf96e017d694487bc},
+    {0xb38d92d760ec4455, 0x37c981dcc395a9ac},
+    {0xe070f78d3927556a, 0x85bbe253f47b1417},
+    {0x8c469ab843b89562, 0x93956d7478ccec8e},
+    {0xaf58416654a6babb, 0x387ac8d1970027b2},
+    {0xdb2e51bfe9d0696a, 0x06997b05fcc0319e},
+    {0x88fcf317f22241e2, 0x441fece3bdf81f03},
+    {0xab3c2fddeeaad25a, 0xd527e81cad7626c3},
+    {0xd60b3bd56a5586f1, 0x8a71e223d8d3b074},
+    {0x85c7056562757456, 0xf6872d5667844e49},
+    {0xa738c6bebb12d16c, 0xb428f8ac016561db},
+    {0xd106f86e69d785c7, 0xe13336d701beba52},
+    {0x82a45b450226b39c, 0xecc0024661173473},
+    {0xa34d721642b06084, 0x27f002d7f95d0190},
+    {0xcc20ce9bd35c78a5, 0x31ec038df7b441f4},
+    {0xff290242c83396ce, 0x7e67047175a15271},
+    {0x9f79a169bd203e41, 0x0f0062c6e984d386},
+    {0xc75809c42c684dd1, 0x52c07b78a3e60868},
+    {0xf92e0c3537826145, 0xa7709a56ccdf8a82},
+    {0x9bbcc7a142b17ccb, 0x88a66076400bb691},
+    {0xc2abf989935ddbfe, 0x6acff893d00ea435},
+    {0xf356f7ebf83552fe, 0x0583f6b8c4124d43},
+    {0x98165af37b2153de, 0xc3727a337a8b704a},
+    {0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c},
+    {0xeda2ee1c7064130c, 0x1162def06f79df73},
+    {0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8},
+    {0xb9a74a0637ce2ee1, 0x6d953e2bd7173692},
+    {0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437},
+    {0x910ab1d4db9914a0, 0x1d9c9892400a22a2},
+    {0xb54d5e4a127f59c8, 0x2503beb6d00cab4b},
+    {0xe2a0b5dc971f303a, 0x2e44ae64840fd61d},
+    {0x8da471a9de737e24, 0x5ceaecfed289e5d2},
+    {0xb10d8e1456105dad, 0x7425a83e872c5f47},
+    {0xdd50f1996b947518, 0xd12f124e28f77719},
+    {0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f},
+    {0xace73cbfdc0bfb7b, 0x636cc64d1001550b},
+    {0xd8210befd30efa5a, 0x3c47f7e05401aa4e},
+    {0x8714a775e3e95c78, 0x65acfaec34810a71},
+    {0xa8d9d1535ce3b396, 0x7f1839a741a14d0d},
+    {0xd31045a8341ca07c, 0x1ede48111209a050},
+    {0x83ea2b892091e44d, 0x934aed0aab460432},
+    {0xa4e4b66b68b65d60, 0xf81da84d5617853f},
+    {0xce1de40642e3f4b9, 0x36251260ab9d668e},
+    {0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019},
+    {0xa1075a24e4421730, 0xb24cf65b8612f81f},
+    {0xc94930ae1d529cfc, 0xdee033f26797b627},
+    {0xfb9b7cd9a4a7443c, 0x169840ef017da3b1},
+    {0x9d412e0806e88aa5, 0x8e1f289560ee864e},
+    {0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2},
+    {0xf5b5d7ec8acb58a2, 0xae10af696774b1db},
+    {0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29},
+    {0xbff610b0cc6edd3f, 0x17fd090a58d32af3},
+    {0xeff394dcff8a948e, 0xddfc4b4cef07f5b0},
+    {0x95f83d0a1fb69cd9, 0x4abdaf101564f98e},
+    {0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1},
+    {0xea53df5fd18d5513, 0x84c86189216dc5ed},
+    {0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4},
+    {0xb7118682dbb66a77, 0x3fbc8c33221dc2a1},
+    {0xe4d5e82392a40515, 0x0fabaf3feaa5334a},
+    {0x8f05b1163ba6832d, 0x29cb4d87f2a7400e},
+    {0xb2c71d5bca9023f8, 0x743e20e9ef511012},
+    {0xdf78e4b2bd342cf6, 0x914da9246b255416},
+    {0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e},
+    {0xae9672aba3d0c320, 0xa184ac2473b529b1},
+    {0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e},
+    {0x8865899617fb1871, 0x7e2fa67c7a658892},
+    {0xaa7eebfb9df9de8d, 0xddbb901b98feeab7},
+    {0xd51ea6fa85785631, 0x552a74227f3ea565},
+    {0x8533285c936b35de, 0xd53a88958f87275f},
+    {0xa67ff273b8460356, 0x8a892abaf368f137},
+    {0xd01fef10a657842c, 0x2d2b7569b0432d85},
+    {0x8213f56a67f6b29b, 0x9c3b29620e29fc73},
+    {0xa298f2c501f45f42, 0x8349f3ba91b47b8f},
+    {0xcb3f2f7642717713, 0x241c70a936219a73},
+    {0xfe0efb53d30dd4d7, 0xed238cd383aa0110},
+    {0x9ec95d1463e8a506, 0xf4363804324a40aa},
+    {0xc67bb4597ce2ce48, 0xb143c6053edcd0d5},
+    {0xf81aa16fdc1b81da, 0xdd94b7868e94050a},
+    {0x9b10a4e5e9913128, 0xca7cf2b4191c8326},
+    {0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0},
+    {0xf24a01a73cf2dccf, 0xbc633b39673c8cec},
+    {0x976e41088617ca01, 0xd5be0503e085d813},
+    {0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18},
+    {0xec9c459d51852ba2, 0xddf8e7d60ed1219e},
+    {0x93e1ab8252f33b45, 0xcabb90e5c942b503},
+    {0xb8da1662e7b00a17, 0x3d6a751f3b936243},
+    {0xe7109bfba19c0c9d, 0x0cc512670a783ad4},
+    {0x906a617d450187e2, 0x27fb2b80668b24c5},
+    {0xb484f9dc9641e9da, 0xb1f9f660802dedf6},
+    {0xe1a63853bbd26451, 0x5e7873f8a0396973},
+    {0x8d07e33455637eb2, 0xdb0b487b6423e1e8},
+    {0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62},
+    {0xdc5c5301c56b75f7, 0x7641a140cc7810fb},
+    {0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d},
+    {0xac2820d9623bf429, 0x546345fa9fbdcd44},
+    {0xd732290fbacaf133, 0xa97c177947ad4095},
+    {0x867f59a9d4bed6c0, 0x49ed8eabcccc485d},
+    {0xa81f301449ee8c70, 0x5c68f256bfff5a74},
+    {0xd226fc195c6a2f8c, 0x73832eec6fff3111},
+    {0x83585d8fd9c25db7, 0xc831fd53c5ff7eab},
+    {0xa42e74f3d032f525, 0xba3e7ca8b77f5e55},
+    {0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb},
+    {0x80444b5e7aa7cf85, 0x7980d163cf5b81b3},
+    {0xa0555e361951c366, 0xd7e105bcc332621f},
+    {0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7},
+    {0xfa856334878fc150, 0xb14f98f6f0feb951},
+    {0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3},
+    {0xc3b8358109e84f07, 0x0a862f80ec4700c8},
+    {0xf4a642e14c6262c8, 0xcd27bb612758c0fa},
+    {0x98e7e9cccfbd7dbd, 0x8038d51cb897789c},
+    {0xbf21e44003acdd2c, 0xe0470a63e6bd56c3},
+    {0xeeea5d5004981478, 0x1858ccfce06cac74},
+    {0x95527a5202df0ccb, 0x0f37801e0c43ebc8},
+    {0xbaa718e68396cffd, 0xd30560258f54e6ba},
+    {0xe950df20247c83fd, 0x47c6b82ef32a2069},
+    {0x91d28b7416cdd27e, 0x4cdc331d57fa5441},
+    {0xb6472e511c81471d, 0xe0133fe4adf8e952},
+    {0xe3d8f9e563a198e5, 0x58180fddd97723a6},
+    {0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648},
+    {0xb201833b35d63f73, 0x2cd2cc6551e513da},
+    {0xde81e40a034bcf4f, 0xf8077f7ea65e58d1},
+    {0x8b112e86420f6191, 0xfb04afaf27faf782},
+    {0xadd57a27d29339f6, 0x79c5db9af1f9b563},
+    {0xd94ad8b1c7380874, 0x18375281ae7822bc},
+    {0x87cec76f1c830548, 0x8f2293910d0b15b5},
+    {0xa9c2794ae3a3c69a, 0xb2eb3875504ddb22},
+    {0xd433179d9c8cb841, 0x5fa60692a46151eb},
+    {0x849feec281d7f328, 0xdbc7c41ba6bcd333},
+    {0xa5c7ea73224deff3, 0x12b9b522906c0800},
+    {0xcf39e50feae16bef, 0xd768226b34870a00},
+    {0x81842f29f2cce375, 0xe6a1158300d46640},
+    {0xa1e53af46f801c53, 0x60495ae3c1097fd0},
+    {0xca5e89b18b602368, 0x385bb19cb14bdfc4},
+    {0xfcf62c1dee382c42, 0x46729e03dd9ed7b5},
+    {0x9e19db92b4e31ba9, 0x6c07a2c26a8346d1},
+};
+
+static int jsonw_clz64(uint64_t x) {
+#ifdef __GNUC__
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  for (; !(x >> 63); x <<= 1)
+    n++;
+  return n;
+#endif
+}
+
+// full 64 by 64 bit multiplication. returns the low half
+static uint64_t jsonw_mul128(uint64_t a, uint64_t b, uint64_t *hi) {
+#ifdef __SIZEOF_INT128__
+  __extension__ typedef unsigned __int128 uint128_t;
+  uint128_t p = (uint128_t)a * b;
+  return *hi = p >> 64, (uint64_t)p;
+#else
+  uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+  uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+  *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+  return mid << 32 | (uint32_t)p00;
+#endif
+}
+#define DBL_INF ((uint64_t)0x7ff << 52)
+
+// the Eisel-Lemire algorithm: returns the bit pattern of the `double` nearest
+// to `w * 10^q` for a nonzero `w`. `exact` is cleared if the 128-bit product
+// is too close to a rounding boundary for the result to be trusted
+static uint64_t jsonw_lemire(bool *exact, uint64_t w, long long q) {
+  *exact = true;
+  if (q < -342)
+    return 0;
+  if (q > 308)
+    return DBL_INF;
+
+  int lz = jsonw_clz64(w);
+  uint64_t hi, lo = jsonw_mul128(w <<= lz, jsonw_pow5[q + 342][0], &hi);
+  if ((hi & 0x1ff) == 0x1ff) {
+    uint64_t hi2;
+    jsonw_mul128(w, jsonw_pow5[q + 342][1], &hi2);
+    lo += hi2, hi += lo < hi2;
+  }
+  if (lo == UINT64_MAX && (q < -27 || q > 55))
+    *exact = false;
+
+  // `floor(q * log2(10)) + 63`, without shifting negative numbers
+  long long log2 = q * 217706, power2 = 63 + 1023 + (int)(hi >> 63) - lz;
+  power2 += log2 >= 0 ? log2 / 65536 : -((-log2 + 65535) / 65536);
+  int shift = (int)(hi >> 63) + 9;
+  uint64_t mantissa = hi >> shift;
+
+  if (power2 <= 0) { // subnormal
+    if (-power2 + 1 >= 64)
+      return 0;
+    mantissa >>= -power2 + 1;
+    // a carry into bit 52 makes for the smallest normal number
+    return (mantissa + (mantissa & 1)) >> 1;
+  }
+
+  // exactly halfway between two `double`s; round to even
+  if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+      mantissa << shift == hi)
+    mantissa &= ~(uint64_t)1;
+  mantissa = (mantissa + (mantissa & 1)) >> 1;
+  if (mantissa >= (uint64_t)2 << 52)
+    mantissa = (uint64_t)1 << 52, power2++;
+  mantissa &= ~((uint64_t)1 << 52);
+  return power2 >= 0x7ff ? DBL_INF : (uint64_t)power2 << 52 | mantissa;
+}
+
+// arbitrary-precision fallback for when `jsonw_lemire` can't decide. big enough
+// for 800 significant digits times the largest power of 5 that can occur
+#define BIG_LIMBS 128
+typedef struct {
+  uint32_t limb[BIG_LIMBS]; // little endian
+  int len;
+} jsonw_big;
+
+static void jsonw_bigmul(jsonw_big *big, uint32_t mul, uint32_t add) {
+  uint64_t carry = add;
+  for (int i = 0; i < big->len; i++, carry >>= 32)
+    carry += (uint64_t)big->limb[i] * mul, big->limb[i] = (uint32_t)carry;
+  if (carry)
+    big->limb[big->len++] = (uint32_t)carry;
+}
+
+static void jsonw_bigpow5(jsonw_big *big, long long exp) {
+  static const uint32_t pow5[] = {1,      5,       25,       125,      625,
+                                  3125,   15625,   78125,    390625,   1953125,
+                                  9765625, 48828125, 244140625, 1220703125};
+  for (; exp >= 13; exp -= 13)
+    jsonw_bigmul(big, pow5[13], 0);
+  jsonw_bigmul(big, pow5[exp], 0);
+}
+
+static long long jsonw_bigbits(jsonw_big *big) {
+  if (big->len == 0)
+    return 0;
+  long long bits = 32LL * big->len;
+  for (uint32_t top = big->limb[big->len - 1]; !(top >> 31); top <<= 1)
+    bits--;
+  return bits;
+}
+
+static void jsonw_bigshl(jsonw_big *big, long long n) {
+  int limbs = (int)(n / 32), bits = (int)(n % 32);
+  big->limb[big->len] = 0;
+  for (int i = big->len; i >= 0; i--)
+    big->limb[i + limbs] = big->limb[i] << bits |
+                           (bits && i ? big->limb[i - 1] >> (32 - bits) : 0);
+  for (int i = 0; i < limbs; i++)
+    big->limb[i] = 0;
+  big->len += limbs + 1;
+  while (big->len && big->limb[big->len - 1] == 0)
+    big->len--;
+}
+
+static int jsonw_bigcmp(jsonw_big *a, jsonw_big *b) {
+  if (a->len != b->len)
+    return a->len < b->len ? -1 : 1;
+  for (int i = a->len - 1; i >= 0; i--)
+    if (a->limb[i] != b->limb[i])
+      return a->limb[i] < b->limb[i] ? -1 : 1;
+  return 0;
+}
+
+// sign of `digits * 10^exp - h`, where `h` lies halfway between the `double`
+// with bit pattern `bits` and the one after it
+static int jsonw_cmphalf(jsonw_big *digits, long long exp, uint64_t bits) {
+  uint64_t m = bits & (((uint64_t)1 << 52) - 1);
+  long long e = (long long)(bits >> 52);
+  e ? (m |= (uint64_t)1 << 52, e -= 1075) : (e = -1074);
+  m = 2 * m + 1, e -= 1; // `h` is `m * 2^e`
+
+  jsonw_big a = *digits, b = {{(uint32_t)m, (uint32_t)(m >> 32)}, 2};
+  b.len -= b.limb[1] == 0;
+  long long ea = 0, eb = e;
+  exp >= 0 ? (jsonw_bigpow5(&a, exp), ea += exp)
+           : (jsonw_bigpow5(&b, -exp), eb -= exp);
+
+  long long la = jsonw_bigbits(&a) + ea, lb = jsonw_bigbits(&b) + eb;
+  if (la != lb)
+    return la < lb ? -1 : 1;
+  ea > eb ? jsonw_bigshl(&a, ea - eb) : jsonw_bigshl(&b, eb - ea);
+  return jsonw_bigcmp(&a, &b);
+}
+
+// correctly rounds the number whose digits start at `json` and whose explicit
+// exponent is `exp`, given `bits` within a few units in the last place
+static uint64_t jsonw_slowpath(char *end, char *json, long long exp,
+                               uint64_t bits) {
+  jsonw_big digits = {{0}, 0};
+  uint32_t chunk = 0;
+  int n = 0, len = 0; // significant digits, digits in `chunk`
+  bool frac = false, sticky = false;
+
+  // keep 800 significant digits; any digit that is nonzero beyond that only
+  // matters as a sticky digit, as halfway points never have more than 767
+  for (; ISDIGIT(AT(json)) || AT(json) == '.' && (frac = true); json++) {
+    if (*json == '.' || n == 0 && *json == '0' && (exp -= frac, 1))
+      continue;
+    if (n < 800) {
+      chunk = chunk * 10 + (*json - '0'), n++, len++, exp -= frac;
+      if (len == 9)
+        jsonw_bigmul(&digits, 1000000000, chunk), chunk = 0, len = 0;
+    } else
+      sticky |= *json != '0', exp += !frac;
+  }
+  jsonw_bigmul(&digits, (uint32_t)jsonw_pow10[len], chunk);
+  if (sticky)
+    jsonw_bigmul(&digits, 10, 1), exp--;
+
+  int c;
+  if (bits >= DBL_INF)
+    bits = DBL_INF - 1;
+  while (bits > 0 && ((c = jsonw_cmphalf(&digits, exp, bits - 1)) < 0 ||
+                      c == 0 && bits & 1))
+    bits--;
+  while (bits < DBL_INF && ((c = jsonw_cmphalf(&digits, exp, bits)) > 0 ||
+                            c == 0 && bits & 1))
+    bits++;
+  return bits;
+}
+
+char *jsonw_number_n(double *num, char *end, char *json) {
   OUT_PARAM(double, num);
   if (json == NULL)
     return NULL;
+  STAT_CALL(NUMBER, json);
 
-  int sign = *json == '-' && json++ ? -1 : 1;
-  double significand = 0.0;
-  // using an unsigned type because integer overflow has undefined behavior
-  unsigned short shift = 0, exponent = 0;
+  bool negative = AT(json) == '-' && json++;
+  char *digits = json;
+  // the value is `w * 10^q`, where `w` holds the first 19 significant digits.
+  // `trunc` is set if nonzero digits beyond those were dropped
+  uint64_t w = 0;
+  long long q = 0, exp = 0;
+  int n = 0;
+  bool trunc = false;
 
-#define DIGIT_PLUS(LVALUE)                                                     \
+  // digits beyond the first 19 significant ones only move the decimal point
+  // and tell whether anything nonzero was dropped
+#define DIGIT_PLUS(FRAC)                                                       \
   do {                                                                         \
-    if (!isdigit(*json))                                                       \
+    if (!ISDIGIT(AT(json)))                                                    \
       return NULL;                                                             \
-    for (; isdigit(*json); json++)                                             \
-      LVALUE *= 10, LVALUE += *json - '0';                                     \
+    for (; FRAC && w == 0 && AT(json) == '0'; json++)                          \
+      q--;                                                                     \
+    char *j = json;                                                            \
+    json = jsonw_digits(&w, 19 - n, end, json);                                \
+    n += json - j, q -= FRAC * (json - j);                                     \
+    for (; ISDIGIT(AT(json)); json++)                                          \
+      trunc |= *json != '0', q += !FRAC;                                       \
   } while (0)
 
-  if (*json == '0' && json++)
+  if (AT(json) == '0' && json++)
     ;
   else
-    DIGIT_PLUS(significand);
+    DIGIT_PLUS(0);
 
-  if (*json == '.' && json++) {
-    char *j = json;
-    DIGIT_PLUS(significand);
-    shift = json - j;
-  }
+  if (AT(json) == '.' && json++)
+    DIGIT_PLUS(1);
 
-  if ((*json == 'e' || *json == 'E') && json++) {
-    int sign = *json == '-' && json++ ? -1 : (*json == '+' && json++, 1);
-    DIGIT_PLUS(exponent);
-    exponent *= sign;
+  if ((AT(json) == 'e' || AT(json) == 'E') && json++) {
+    int sign = AT(json) == '-' && json++ ? -1 : (AT(json) == '+' && json++, 1);
+    if (!ISDIGIT(AT(json)))
+      return NULL;
+    // saturate well beyond any exponent that could possibly matter
+    for (; ISDIGIT(AT(json)); json++)
+      if (exp < 100000000000000000)
+        exp = exp * 10 + (*json - '0');
+    q += exp *= sign;
   }
 
 #undef DIGIT_PLUS
 
-  exponent -= shift, significand *= sign;
-  // conversion from `unsigned short` to `short` preserves bit pattern
-  for (; (short)exponent > 0; exponent--)
-    significand *= 10;
-  for (; (short)exponent < 0; exponent++)
-    significand /= 10;
+  double value;
+  if (w == 0)
+    value = 0.0;
+  else if (FLT_EVAL_METHOD == 0 && !trunc && w <= (uint64_t)1 << 53 &&
+           q >= -22 && q <= 22)
+    // both operands are exact, so the result is correctly rounded
+    value = q < 0 ? (double)w / jsonw_pow10[-q] : (double)w * jsonw_pow10[q];
+  else {
+    bool exact, exact_succ;
+    uint64_t bits = jsonw_lemire(&exact, w, q);
+    // the true value lies between `w * 10^q` and `(w + 1) * 10^q`
+    if (trunc && bits != jsonw_lemire(&exact_succ, w + 1, q))
+      exact = false;
+    if (!exact)
+      bits = jsonw_slowpath(end, digits, exp, bits);
+    memcpy(&value, &bits, sizeof(value));
+  }
 
-  return *num = significand, json;
+  return *num = negative ? -value : value, STAT_OK(NUMBER, json);
 }
 
-char *jsonw_character(char *chr, char *json) {
+// integers share the grammar of numbers but must have neither a fraction nor
+// an exponent. the magnitude is exact; overflow is a parse failure
+static char *jsonw_integer(bool *negative, uint64_t *mag, char *end,
+                           char *json) {
+  if (json == NULL)
+    return NULL;
+
+  *negative = AT(json) == '-' && json++, *mag = 0;
+  if (AT(json) == '0' && json++)
+    ;
+  else if (!ISDIGIT(AT(json)))
+    return NULL;
+  else {
+    // 19 digits always fit. a 20th may or may not
+    char *j = json;
+    json = jsonw_digits(mag, 19, end, json);
+    if (json - j == 19 && ISDIGIT(AT(json))) {
+      if (*mag > (UINT64_MAX - (*json - '0')) / 10)
+        return NULL;
+      *mag = *mag * 10 + (*json++ - '0');
+    }
+    if (ISDIGIT(AT(json)))
+      return NULL;
+  }
+
+  if (AT(json) == '.' || AT(json) == 'e' || AT(json) == 'E')
+    return NULL;
+  return json;
+}
+
+char *jsonw_int64_n(int64_t *num, char *end, char *json) {
+  OUT_PARAM(int64_t, num);
+  STAT_CALL(INT64, json);
+  bool negative;
+  uint64_t mag;
+  if ((json = jsonw_integer(&negative, &mag, end, json)) == NULL ||
+      mag > (uint64_t)INT64_MAX + negative)
+    return NULL;
+  // negating `INT64_MIN` would overflow, so negate one less than it
+  return *num = negative && mag ? -(int64_t)(mag - 1) - 1 : (int64_t)mag,
+         STAT_OK(INT64, json);
+}
+
+char *jsonw_uint64_n(uint64_t *num, char *end, char *json) {
+  OUT_PARAM(uint64_t, num);
+  STAT_CALL(UINT64, json);
+  bool negative;
+  uint64_t mag;
+  if ((json = jsonw_integer(&negative, &mag, end, json)) == NULL ||
+      negative && mag)
+    return NULL;
+  return *num = mag, STAT_OK(UINT64, json);
+}
+
+// the elements of an array of only numbers, parsed by `PARSER` into `out`,
+// without dispatching on the type of each element
+#define NUMBERS(PARSER)                                                        \
+  do {                                                                         \
+    OUT_PARAM(size_t, count);                                                  \
+    size_t n = 0;                                                              \
+    if ((json = jsonw_beginarr_n(end, json)) && AT(json) == ']')               \
+      return *count = 0, jsonw_ws_n(end, json + 1);                            \
+    for (; n < cap && (json = PARSER(out + n, end, json)); n++) {              \
+      if (json = jsonw_ws_n(end, json), AT(json) == ',')                       \
+        json = jsonw_ws_n(end, json + 1);                                      \
+      else if (json = jsonw_endarr_n(end, json))                               \
+        return *count = n + 1, json;                                           \
+    }                                                                          \
+    return NULL;                                                               \
+  } while (0)
+
+char *jsonw_numbers_n(double *out, size_t cap, size_t *count, char *end,
+                      char *json) {
+  NUMBERS(jsonw_number_n);
+}
+
+char *jsonw_int64s_n(int64_t *out, size_t cap, size_t *count, char *end,
+                     char *json) {
+  NUMBERS(jsonw_int64_n);
+}
+
+#undef NUMBERS
+
+#undef DBL_INF
+#undef BIG_LIMBS
+
+// 0x10 for hexadecimal digits, plus their value
+static const unsigned char jsonw_hexdigits[256] = {
+    ['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,
+    ['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+    ['a'] = 0x1a, ['b'] = 0x1b, ['c'] = 0x1c, ['d'] = 0x1d, ['e'] = 0x1e,
+    ['f'] = 0x1f, ['A'] = 0x1a, ['B'] = 0x1b, ['C'] = 0x1c, ['D'] = 0x1d,
+    ['E'] = 0x1e, ['F'] = 0x1f,
+};
+
+// the four hexadecimal digits of a '\uXXXX' escape
+static char *jsonw_hex4(uint32_t *codept, char *end, char *json) {
+  uint32_t cp = 0;
+  for (int i = 0; i < 4; i++, json++) {
+    unsigned char hex = jsonw_hexdigits[(unsigned char)AT(json)];
+    if (hex == 0)
+      return NULL;
+    cp = cp << 4 | (hex & 0xf);
+  }
+  return *codept = cp, json;
+}
+
+char *jsonw_character_n(char *chr, char *end, char *json) {
   OUT_PARAM(char, chr);
   if (json == NULL)
     return NULL;
 
-  if (*json == '\\' && json++) {
+  if (AT(json) == '\\' && json++) {
     char *escape, *escapes = JSON_ESCAPES;
-    if (*json && (escape = strchr(escapes, *json)) && json++)
+    if (AT(json) && (escape = strchr(escapes, *json)) && json++)
       return *chr = JSON_CODEPTS[escape - escapes], json;
 
-    if (*json == 'u' && json++) {
-      // ISO/IEC 9899:TC3, $5.2.4.2.1: `USHRT_MAX` is at least 65535
-      unsigned short codept = 0;
-      for (int i = 0; i < 4; i++) {
-        if (!isxdigit(*json))
-          return NULL;
-        codept <<= 4;
-        codept |= isdigit(*json) ? *json++ - '0' : tolower(*json++) - 'a' + 10;
-      }
-
+    uint32_t codept;
+    if (AT(json) == 'u' && (json = jsonw_hex4(&codept, end, json + 1)))
       // if a '\uXXXX' escape is beyond 7-bit ASCII, return a sentinel '\0'
-      // and let clients handle things themselves if they so wish. unicode
-      // shenanigans are beyond the scope of this library
+      // and let clients decode it with `jsonw_utf8chr` if they so wish
       return *chr = codept <= 0x7f ? codept : '\0', json;
-    }
 
     return NULL;
   }
 
-  if ((unsigned char)*json >= ' ' && *json != '"')
+  if ((unsigned char)AT(json) >= ' ' && *json != '"')
     return *chr = *json, ++json;
 
   return NULL;
 }
 
-char *jsonw_string(size_t *len, char *json) {
+char *jsonw_utf8chr_n(char buf[4], size_t *len, char *end, char *json) {
   OUT_PARAM(size_t, len);
-  size_t length = 0; // only write to `len` on success
-  char *j = json = jsonw_beginstr(json);
-  while (j = jsonw_character(NULL, j))
-    json = j, length++;
-  if (json = jsonw_endstr(json))
-    return *len = length, json;
-  return NULL;
-}
+  uint32_t cp, lo;
+  char *low;
+  if (json == NULL)
+    return NULL;
+  if (AT(json) != '\\' || AT(json + 1) != 'u')
+    return (json = jsonw_character_n(buf, end, json)) && (*len = 1), json;
+  if ((json = jsonw_hex4(&cp, end, json + 2)) == NULL)
+    return NULL;
 
-char *jsonw_name(char *json) { return jsonw_namesep(jsonw_string(NULL, json)); }
+  // a high surrogate escaped right before a low surrogate joins with it.
+  // UTF-8 can't encode lone surrogates, so they become U+FFFD
+  if (cp >= 0xd800 && cp < 0xdc00 && AT(json) == '\\' &&
+      AT(json + 1) == 'u' && (low = jsonw_hex4(&lo, end, json + 2)) &&
+      lo >= 0xdc00 && lo < 0xe000)
+    cp = 0x10000 + ((cp - 0xd800) << 10 | (lo - 0xdc00)), json = low;
+  else if (cp >= 0xd800 && cp < 0xe000)
+    cp = 0xfffd;
 
-char *jsonw_element(char *json) {
-  return jsonw_valuesep(jsonw_value(NULL, json));
+  if (cp < 0x80)
+    return buf[0] = cp, *len = 1, json;
+  if (cp < 0x800)
+    return buf[0] = 0xc0 | cp >> 6, buf[1] = 0x80 | (cp & 0x3f), *len = 2,
+           json;
+  if (cp < 0x10000)
+    return buf[0] = 0xe0 | cp >> 12, buf[1] = 0x80 | (cp >> 6 & 0x3f),
+           buf[2] = 0x80 | (cp & 0x3f), *len = 3, json;
+  return buf[0] = 0xf0 | cp >> 18, buf[1] = 0x80 | (cp >> 12 & 0x3f),
+         buf[2] = 0x80 | (cp >> 6 & 0x3f), buf[3] = 0x80 | (cp & 0x3f),
+         *len = 4, json;
 }
 
-char *jsonw_member(char *json) { return jsonw_element(jsonw_name(json)); }
+// whether the run of unescaped characters from `RUN` to `JSON` is valid.
+// escapes are ASCII, so runs between them hold whole UTF-8 sequences
+#ifdef JSONW_VALIDATE_UTF8
+#define VALID_RUN(JSON, RUN) (jsonw_utf8_n(JSON, RUN) != NULL)
+#else
+#define VALID_RUN(JSON, RUN) true
+#endif
 
-char *jsonw_array(size_t *len, char *json) {
+char *jsonw_string_n(size_t *len, char *end, char *json) {
   OUT_PARAM(size_t, len);
+  STAT_CALL(STRING, json);
   size_t length = 0; // only write to `len` on success
-  char *j = json = jsonw_beginarr(json);
-  if (j = jsonw_endarr(json))
-    return *len = length, j;
-  for (; json = jsonw_value(NULL, json); json = jsonw_valuesep(json), length++)
-    if (j = jsonw_endarr(json))
-      return *len = length, j;
+  if ((json = jsonw_beginstr_n(end, json)) == NULL)
+    return NULL;
+  // skip runs of unescaped characters in bulk. only escapes need parsing
+  for (char *run;; length++) {
+    json = jsonw_scanstr(end, run = json), length += json - run;
+    if (!VALID_RUN(json, run))
+      return NULL;
+    if (AT(json) != '\\')
+      break;
+    if ((json = jsonw_character_n(NULL, end, json)) == NULL)
+      return NULL;
+  }
+  if (json = jsonw_endstr_n(end, json))
+    return *len = length, STAT_OK(STRING, json);
   return NULL;
 }
 
-char *jsonw_object(size_t *len, char *json) {
+char *jsonw_rawstr_n(size_t *len, bool *esc, char *end, char *json) {
   OUT_PARAM(size_t, len);
-  size_t length = 0; // only write to `len` on success
-  char *j = json = jsonw_beginobj(json);
-  if (j = jsonw_endobj(json))
-    return *len = length, j;
-  for (; json = jsonw_value(NULL, jsonw_name(json));
-       json = jsonw_valuesep(json), length++)
-    if (j = jsonw_endobj(json))
-      return *len = length, j;
+  OUT_PARAM(bool, esc);
+  STAT_CALL(RAWSTR, json);
+  bool escapes = false; // only write to `esc` on success
+  char *raw = json = jsonw_beginstr_n(end, json), *run;
+  if (json == NULL)
+    return NULL;
+  while (json = jsonw_scanstr(end, run = json), AT(json) == '\\')
+    if (escapes = true, !VALID_RUN(json, run) ||
+                            (json = jsonw_character_n(NULL, end, json)) == NULL)
+      return NULL;
+  char *quote = json;
+  if (VALID_RUN(json, run) && (json = jsonw_endstr_n(end, json)))
+    return *len = quote - raw, *esc = escapes, STAT_OK(RAWSTR, json);
   return NULL;
 }
 
-char *jsonw_primitive(jsonw_ty *type, char *json) {
+char *jsonw_name_n(char *end, char *json) {
+  return jsonw_namesep_n(end, jsonw_string_n(NULL, end, json));
+}
+
+char *jsonw_element_n(char *end, char *json) {
+  return jsonw_valuesep_n(end, jsonw_value_n(NULL, end, json));
+}
+
+char *jsonw_member_n(char *end, char *json) {
+  return jsonw_element_n(end, jsonw_name_n(end, json));
+}
+
+// skips over the array or object `json` points to without recursing, keeping
+// a bit per nesting level, set for objects, in a fixed-size stack
+static char *jsonw_nested(size_t *len, char *end, char *json) {
+  OUT_PARAM(size_t, len);
+  unsigned char stack[(JSONW_MAX_DEPTH + CHAR_BIT - 1) / CHAR_BIT];
+  size_t length = 0, depth = 0; // only write to `len` on success
+
+#define IN_OBJECT (stack[(depth - 1) / CHAR_BIT] >> (depth - 1) % CHAR_BIT & 1)
+
+  while (1) {
+    if (AT(json) == '[' || AT(json) == '{') {
+      if (depth == JSONW_MAX_DEPTH)
+        return NULL;
+      stack[depth / CHAR_BIT] &= ~(1 << depth % CHAR_BIT);
+      stack[depth / CHAR_BIT] |= (*json == '{') << depth % CHAR_BIT;
+      depth++, json = jsonw_ws_n(end, json + 1);
+      STAT_DEPTH(depth);
+      if (AT(json) == (IN_OBJECT ? '}' : ']'))
+        goto close;
+      if (IN_OBJECT && (json = jsonw_name_n(end, json)) == NULL)
+        return NULL;
+      continue; // to the first value
+    }
+
+    if ((json = jsonw_primitive_n(NULL, end, json)) == NULL)
+      return NULL;
+
+    while (1) {
+      // a value was just parsed at the current depth
+      if (depth == 1)
+        length++;
+      json = jsonw_ws_n(end, json);
+      if (AT(json) == ',') {
+        json = jsonw_ws_n(end, json + 1);
+        if (IN_OBJECT && (json = jsonw_name_n(end, json)) == NULL)
+          return NULL;
+        break; // to the next value
+      }
+
+      if (AT(json) != (IN_OBJECT ? '}' : ']'))
+        return NULL;
+    close:
+      depth--, json = jsonw_ws_n(end, json + 1);
+      if (depth == 0)
+        return *len = length, json;
+    }
+  }
+
+#undef IN_OBJECT
+}
+
+char *jsonw_array_n(size_t *len, char *end, char *json) {
+  STAT_CALL(ARRAY, json);
+  json = jsonw_ws_n(end, json);
+  return json && AT(json) == '[' ? STAT_OK(ARRAY, jsonw_nested(len, end, json))
+                                 : NULL;
+}
+
+char *jsonw_object_n(size_t *len, char *end, char *json) {
+  STAT_CALL(OBJECT, json);
+  json = jsonw_ws_n(end, json);
+  return json && AT(json) == '{' ? STAT_OK(OBJECT, jsonw_nested(len, end, json))
+                                 : NULL;
+}
+
+char *jsonw_primitive_n(jsonw_ty *type, char *end, char *json) {
   OUT_PARAM(jsonw_ty, type);
-  char *j;
-  (j = jsonw_null(json)) && (*type = JSONW_NULL, 1) ||
-      (j = jsonw_boolean(NULL, json)) && (*type = JSONW_BOOLEAN) ||
-      (j = jsonw_number(NULL, json)) && (*type = JSONW_NUMBER) ||
-      (j = jsonw_string(NULL, json)) && (*type = JSONW_STRING);
-  return j;
+  STAT_CALL(PRIMITIVE, json);
+  char *j = NULL;
+  // the first character determines which parser can possibly succeed, so
+  // dispatch on it instead of trying every parser in turn
+  switch (json ? AT(json) : '\0') {
+  case 'n':
+    (j = jsonw_null_n(end, json)) && (*type = JSONW_NULL, 1);
+    break;
+  case 't':
+  case 'f':
+    (j = jsonw_boolean_n(NULL, end, json)) && (*type = JSONW_BOOLEAN);
+    break;
+  case '-':
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    (j = jsonw_number_n(NULL, end, json)) && (*type = JSONW_NUMBER);
+    break;
+  case '"':
+    (j = jsonw_string_n(NULL, end, json)) && (*type = JSONW_STRING);
+    break;
+  default:
+    return NULL; // no parser can possibly succeed
+  }
+  STAT_MISS(j);
+  return STAT_OK(PRIMITIVE, j);
 }
 
-char *jsonw_structured(jsonw_ty *type, char *json) {
+char *jsonw_structured_n(jsonw_ty *type, char *end, char *json) {
   OUT_PARAM(jsonw_ty, type);
-  char *j;
-  (j = jsonw_array(NULL, json)) && (*type = JSONW_ARRAY) ||
-      (j = jsonw_object(NULL, json)) && (*type = JSONW_OBJECT);
-  return j;
+  STAT_CALL(STRUCTURED, json);
+  char *j = NULL, *ws = jsonw_ws_n(end, json);
+  // `jsonw_beginarr` and `jsonw_beginobj` skip leading whitespace, so we must
+  // too before dispatching
+  switch (ws ? AT(ws) : '\0') {
+  case '[':
+    (j = jsonw_array_n(NULL, end, json)) && (*type = JSONW_ARRAY);
+    break;
+  case '{':
+    (j = jsonw_object_n(NULL, end, json)) && (*type = JSONW_OBJECT);
+    break;
+  default:
+    return NULL;
+  }
+  STAT_MISS(j);
+  return STAT_OK(STRUCTURED, j);
 }
 
-char *jsonw_value(jsonw_ty *type, char *json) {
-  // `jsonw_array` calls `jsonw_value` and `jsonw_value` calls `jsonw_array`,
-  // resulting in a cycle when `json == NULL`. this check breaks that cycle
+// the grammar of values, checked even in trusted builds for `jsonw_text`
+static char *jsonw_checked(jsonw_ty *type, char *end, char *json) {
   if (json == NULL)
     return NULL;
+  STAT_CALL(VALUE, json);
 
-  // no need to `OUT_PARAM(json_ty, type)` because we don't dereference it
-  char *j;
-  (j = jsonw_primitive(type, json)) || (j = jsonw_structured(type, json));
-  return j;
+  // no need to `OUT_PARAM(json_ty, type)` because we don't dereference it.
+  // primitives never start with whitespace but structured types may
+  switch (AT(json)) {
+  case '[':
+  case '{':
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\r':
+    return STAT_OK(VALUE, jsonw_structured_n(type, end, json));
+  default:
+    return STAT_OK(VALUE, jsonw_primitive_n(type, end, json));
+  }
 }
 
-char *jsonw_text(jsonw_ty *type, char *json) {
+char *jsonw_value_n(jsonw_ty *type, char *end, char *json) {
+#ifdef JSONW_TRUSTED
+  return jsonw_value_u(type, end, json);
+#else
+  return jsonw_checked(type, end, json);
+#endif
+}
+
+char *jsonw_text_n(jsonw_ty *type, char *end, char *json) {
   // no need to `OUT_PARAM(json_ty, type)` because we don't dereference it
-  return jsonw_ws(jsonw_value(type, jsonw_ws(json)));
+  STAT_CALL(TEXT, json);
+  json = jsonw_ws_n(end, jsonw_checked(type, end, jsonw_ws_n(end, json)));
+  return STAT_OK(TEXT, json);
 }
 
 // utilities
 
-int jsonw_strcmp(char *str, char *json) {
+int jsonw_strcmp_n(char *str, char *end, char *json) {
   // compare is performed without normalization
   char c;
-  do
-    c = '\0', json = jsonw_character(&c, json);
-  while (*str && *str == c && str++);
+  do {
+    // compare runs of unescaped characters directly
+    for (char *run = json ? jsonw_scanstr(end, json) : json; json != run;
+         json++)
+      if (*str++ != *json)
+        return str[-1] - *json;
+    c = '\0', json = jsonw_character_n(&c, end, json);
+  } while (*str && *str == c && str++);
   return *str - c;
 }
 
-char *jsonw_index(size_t idx, char *json) {
+char *jsonw_index_n(size_t idx, char *end, char *json) {
   while (idx--)
-    json = jsonw_element(json);
+    json = jsonw_element_n(end, json);
   return json;
 }
 
-char *jsonw_find(char *name, char *json) {
+char *jsonw_begincur_n(jsonw_cursor *cur, char *end, char *json) {
+  OUT_PARAM(jsonw_cursor, cur);
+  if ((json = jsonw_beginarr_n(end, json)) == NULL)
+    return NULL;
+  *cur = (jsonw_cursor){end, json, json, 0, SIZE_MAX, NULL};
+  if (AT(json) == ']') // no elements
+    cur->len = 0, cur->close = jsonw_ws_n(end, json + 1);
+  return json;
+}
+
+char *jsonw_at(size_t idx, jsonw_cursor *cur) {
+  if (cur == NULL || idx >= cur->len)
+    return NULL;
+  if (idx < cur->idx)
+    cur->elem = cur->first, cur->idx = 0;
+
+  char *end = cur->end;
+  for (char *val, *next; cur->idx < idx; cur->elem = next, cur->idx++)
+    if (next = jsonw_valuesep_n(end, val = jsonw_value_n(NULL, end, cur->elem)),
+        next == NULL) {
+      // past the last element, which makes for the number of elements
+      if ((cur->close = jsonw_endarr_n(end, val)) != NULL)
+        cur->len = cur->idx + 1;
+      return NULL;
+    }
+  return cur->elem;
+}
+
+char *jsonw_endcur(size_t *len, jsonw_cursor *cur) {
+  OUT_PARAM(size_t, len);
+  if (cur && cur->len == SIZE_MAX)
+    jsonw_at(SIZE_MAX - 1, cur);
+  return cur && cur->close ? *len = cur->len, cur->close : NULL;
+}
+
+char *jsonw_find_n(char *name, char *end, char *json) {
+  STAT_CALL(FIND, json);
   do
-    if (jsonw_strcmp(name, jsonw_beginstr(json)) == 0)
-      return json;
-  while (json = jsonw_member(json));
+    if (jsonw_strcmp_n(name, end, jsonw_beginstr_n(end, json)) == 0)
+      return STAT_OK(FIND, json);
+  while (json = jsonw_member_n(end, json));
   return NULL;
 }
 
-char *jsonw_lookup(char *name, char *json) {
-  return jsonw_name(jsonw_find(name, json));
+char *jsonw_lookup_n(char *name, char *end, char *json) {
+  return jsonw_name_n(end, jsonw_find_n(name, end, json));
+}
+
+static size_t jsonw_keyhash(char *key, size_t len) {
+  unsigned char first = len ? key[0] : 0, last = len ? key[len - 1] : 0;
+  return ((len * 131 + first) * 131 + last) % (2 * JSONW_MAX_KEYS);
+}
+
+bool jsonw_hashkeys(jsonw_keys *keys, char **names, size_t len) {
+  if (len > JSONW_MAX_KEYS)
+    return false;
+
+  keys->names = names, keys->len = len;
+  memset(keys->slots, 0, sizeof(keys->slots));
+  for (size_t i = 0; i < len; i++) {
+    size_t h = jsonw_keyhash(names[i], keys->lens[i] = strlen(names[i]));
+    while (keys->slots[h])
+      h = (h + 1) % (2 * JSONW_MAX_KEYS);
+    keys->slots[h] = i + 1;
+  }
+  return true;
+}
+
+// index of the name equal to the key string literal whose contents start at
+// `json`, or `keys->len` if there is none
+static size_t jsonw_matchkey(jsonw_keys *keys, char *end, char *json) {
+  char *quote = jsonw_scanstr(end, json);
+  if (AT(quote) != '"') {
+    // keys with escapes are compared one by one, without normalization
+    size_t i = 0;
+    while (i < keys->len && jsonw_strcmp_n(keys->names[i], end, json))
+      i++;
+    return i;
+  }
+
+  // keys without escapes are their own raw bytes
+  size_t len = quote - json;
+  for (size_t h = jsonw_keyhash(json, len), i; i = keys->slots[h];
+       h = (h + 1) % (2 * JSONW_MAX_KEYS))
+    if (keys->lens[i - 1] == len && memcmp(keys->names[i - 1], json, len) == 0)
+      return i - 1;
+  return keys->len;
+}
+
+char *jsonw_lookups_n(char **vals, jsonw_keys *keys, bool last, char *end,
+                      char *json) {
+  // `vals` are only written to once the whole object has parsed
+  char *found[JSONW_MAX_KEYS];
+  memset(found, 0, keys->len * sizeof(*found));
+  if (json == NULL)
+    return NULL;
+  STAT_CALL(LOOKUPS, json);
+
+  if (AT(json) != '}')
+    for (char *memb = json, *val; memb; memb = jsonw_valuesep_n(end, json)) {
+      val = jsonw_name_n(end, memb);
+      if ((json = jsonw_value_n(NULL, end, val)) == NULL)
+        return NULL;
+      size_t i = jsonw_matchkey(keys, end, memb + 1);
+      if (i < keys->len && (last || found[i] == NULL))
+        found[i] = val;
+    }
+
+  for (size_t i = 0; i < keys->len; i++)
+    if (found[i])
+      vals[i] = found[i];
+  return STAT_OK(LOOKUPS, json);
+}
+
+// whether the string literal whose contents start at `json` is the `len` raw
+// bytes at `raw`
+static bool jsonw_israw(char *raw, size_t len, char *end, char *json) {
+  // raw bytes of the shape after any escape are compared as well
+  char *quote = jsonw_scanstr(end, json);
+  if (AT(quote) == '"')
+    return quote - json == len && memcmp(raw, json, len) == 0;
+  return quote - json < len && (end ? end - json > len : true) &&
+         strncmp(raw, json, len) == 0 && json[len] == '"';
+}
+
+char *jsonw_shaped_n(char **vals, jsonw_shape *shape, bool last, char *end,
+                     char *json) {
+  jsonw_keys *keys = shape->keys;
+  char *found[JSONW_MAX_KEYS];
+  memset(found, 0, keys->len * sizeof(*found));
+  if (json == NULL)
+    return NULL;
+  STAT_CALL(SHAPED, json);
+
+  // once a name differs from the shape, the shape is relearned from there on
+  // for as long as it fits. the shape is only ever a prediction
+  bool learn = false;
+  size_t n = 0;
+  if (AT(json) != '}')
+    for (char *memb = json, *val; memb;
+         memb = jsonw_valuesep_n(end, json), n++) {
+      size_t i, len;
+      if (!learn && n < shape->len && AT(memb) == '"' &&
+          jsonw_israw(shape->raw + shape->offs[n],
+                      len = shape->offs[n + 1] - shape->offs[n], end,
+                      memb + 1))
+        i = shape->idx[n], val = jsonw_namesep_n(end, memb + 1 + len + 1);
+      else {
+        if ((val = jsonw_string_n(NULL, end, memb)) == NULL)
+          return NULL;
+        len = val - memb - 2, val = jsonw_namesep_n(end, val);
+        i = jsonw_matchkey(keys, end, memb + 1);
+        if (!learn && n <= shape->len)
+          learn = true, shape->len = n;
+        if (learn && shape->len == n && n < JSONW_MAX_MEMBERS &&
+            shape->offs[n] + len <= sizeof(shape->raw)) {
+          memcpy(shape->raw + shape->offs[n], memb + 1, len);
+          shape->idx[n] = i, shape->offs[n + 1] = shape->offs[n] + len;
+          shape->len = n + 1;
+        }
+      }
+      if ((json = jsonw_value_n(NULL, end, val)) == NULL)
+        return NULL;
+      if (i < keys->len && (last || found[i] == NULL))
+        found[i] = val;
+    }
+
+  for (size_t i = 0; i < keys->len; i++)
+    if (found[i])
+      vals[i] = found[i];
+  return STAT_OK(SHAPED, json);
+}
+
+char *jsonw_document_n(char *end, char *json) {
+  // the next document starts where the text that starts at `json` ends
+  return jsonw_text_n(NULL, end, json);
+}
+
+size_t jsonw_split_n(char **elems, size_t n, char *end, char *json) {
+  char *first = jsonw_beginarr_n(end, json), *elem = first;
+  if (first == NULL || AT(first) == ']' || n == 0)
+    return 0;
+
+  // the text is taken to be mostly the array, so the rest of it is the size
+  size_t len = 0, size = (end ? end : first + strlen(first)) - first;
+  for (; elem && len < n; elem = jsonw_element_n(end, elem))
+    if ((size_t)(elem - first) * n >= len * size)
+      elems[len++] = elem;
+  return len;
 }
 
 char *jsonw_quote(char buf[sizeof("\\u0000")], char chr) {
@@ -261,15 +2053,1479 @@ char *jsonw_quote(char buf[sizeof("\\u0000")], char chr) {
 }
 
 char *jsonw_escape(char *buf, size_t size, char *str) {
-  // the size of `buf` shall be strictly greater than zero
-  for (char *end = buf + size; *str && end - buf >= sizeof("\\u0000"); str++)
-    buf = jsonw_quote(buf, *str);
+  // the size of `buf` shall be strictly greater than zero. characters are
+  // written while there is room for the longest escape, so runs of characters
+  // that need no escaping are copied in bulk up to that point
+  for (char *end = buf + size; *str && end - buf >= sizeof("\\u0000");) {
+    // '/' is escaped too, and runs need not go past the room there is
+    size_t room = end - buf - (sizeof("\\u0000") - 1);
+    size_t run = jsonw_scanrun(NULL, str + room, '/', str) - str;
+    memcpy(buf, str, run), buf += run, str += run;
+    if (*str && end - buf >= sizeof("\\u0000"))
+      buf = jsonw_quote(buf, *str++);
+  }
   return *buf = '\0', str;
 }
 
-char *jsonw_unescape(char *buf, size_t size, char *json) {
+char *jsonw_unescape_n(char *buf, size_t size, char *end, char *json) {
   // the size of `buf` shall be strictly greater than zero
-  for (char *j = json; size-- > 1 && (j = jsonw_character(buf, j)); buf++)
-    json = j;
+  for (char *j; json && size > 1; json = j, buf++, size--) {
+    // copy runs of unescaped characters in bulk
+    size_t run = jsonw_scanrun(end, json + size - 1, '"', json) - json;
+    memcpy(buf, json, run), buf += run, json += run, size -= run;
+    if (size == 1 || (j = jsonw_character_n(buf, end, json)) == NULL)
+      break;
+  }
+  return *buf = '\0', json;
+}
+
+char *jsonw_decode_n(char *buf, size_t size, char *end, char *json) {
+  // the size of `buf` shall be strictly greater than zero
+  for (char *j, chr[4]; json && size > 1; json = j) {
+    // copy runs of unescaped characters in bulk
+    size_t run = jsonw_scanrun(end, json + size - 1, '"', json) - json, len;
+    memcpy(buf, json, run), buf += run, json += run, size -= run;
+    if (size == 1 || (j = jsonw_utf8chr_n(chr, &len, end, json)) == NULL ||
+        len >= size)
+      break;
+    memcpy(buf, chr, len), buf += len, size -= len;
+  }
   return *buf = '\0', json;
 }
+
+char *jsonw_unquote_n(size_t *len, char *end, char *json) {
+  OUT_PARAM(size_t, len);
+  // decoded characters are never longer than their escapes, and the opening
+  // quote is never written out, so writes stay behind reads
+  char *str = json, *buf = json, *run;
+  if ((json = jsonw_beginstr_n(end, json)) == NULL)
+    return NULL;
+  while (json = jsonw_scanstr(end, run = json), AT(json) == '\\') {
+    if (!VALID_RUN(json, run))
+      return NULL;
+    memmove(buf, run, json - run), buf += json - run;
+    if ((json = jsonw_character_n(buf++, end, json)) == NULL)
+      return NULL;
+  }
+  if (AT(json) != '"' || !VALID_RUN(json, run))
+    return NULL;
+  memmove(buf, run, json - run), buf += json - run;
+  return *buf = '\0', *len = buf - str, ++json;
+}
+
+#undef VALID_RUN
+
+// projection
+
+// sets row `row` of `cols` to the values at `vals`, or to missing values
+static void jsonw_setrow(jsonw_column *cols, size_t n, size_t row, char **vals,
+                         char *end) {
+  for (jsonw_column *col = cols; col < cols + n; col++) {
+    char *val = vals ? vals[col - cols] : NULL;
+    jsonw_span *span;
+    bool ok = false;
+    switch (col->type) {
+    case JSONW_COL_DOUBLE:
+      ok = jsonw_number_n((double *)col->vals + row, end, val) != NULL;
+      break;
+    case JSONW_COL_INT64:
+      ok = jsonw_int64_n((int64_t *)col->vals + row, end, val) != NULL;
+      break;
+    case JSONW_COL_SPAN:
+      span = (jsonw_span *)col->vals + row;
+      ok = jsonw_rawstr_n(&span->len, &span->esc, end, val) &&
+           (span->str = val + 1);
+      break;
+    }
+    unsigned char bit = 1 << row % CHAR_BIT;
+    if (col->valid)
+      col->valid[row / CHAR_BIT] = ok ? col->valid[row / CHAR_BIT] | bit
+                                      : col->valid[row / CHAR_BIT] & ~bit;
+  }
+}
+
+// projects the record `json` into row `row` of `cols`. returns one past the
+// record if it is an object
+static char *jsonw_projrow(jsonw_column *cols, jsonw_shape *shape, size_t row,
+                           char *end, char *json) {
+  char *vals[JSONW_MAX_KEYS];
+  memset(vals, 0, shape->keys->len * sizeof(*vals));
+  json = jsonw_shaped_n(vals, shape, false, end, jsonw_beginobj_n(end, json));
+  json = jsonw_endobj_n(end, json);
+  jsonw_setrow(cols, shape->keys->len, row, json ? vals : NULL, end);
+  return json;
+}
+
+size_t jsonw_project_n(jsonw_column *cols, jsonw_shape *shape, size_t cap,
+                       char *end, char *json) {
+  size_t len = 0;
+  if (json == NULL)
+    return 0;
+  while (json != end && (end || *json)) {
+    char *eol = end ? memchr(json, '\n', end - json) : strchr(json, '\n');
+    eol = eol ? eol : end ? end : json + strlen(json);
+    // records are whole lines, so trailing garbage makes for missing values
+    if (jsonw_ws_n(eol, json) != eol) {
+      if (len < cap && jsonw_projrow(cols, shape, len, eol, json) != eol)
+        jsonw_setrow(cols, shape->keys->len, len, NULL, eol);
+      len++;
+    }
+    json = eol + (eol != end && *eol == '\n');
+  }
+  return len;
+}
+
+size_t jsonw_projectarr_n(jsonw_column *cols, jsonw_shape *shape, size_t cap,
+                          char *end, char *json) {
+  size_t len = 0;
+  char *elem = jsonw_beginarr_n(end, json), *next;
+  if (elem == NULL || AT(elem) == ']')
+    return 0;
+  for (; elem; elem = next, len++) {
+    // elements that aren't objects are skipped over as values
+    next = len < cap ? jsonw_projrow(cols, shape, len, end, elem) : NULL;
+    next = next ? jsonw_valuesep_n(end, next) : jsonw_element_n(end, elem);
+  }
+  return len;
+}
+
+// writing
+
+// a floating-point number `f * 2^e` with a 64-bit significand
+typedef struct {
+  uint64_t f;
+  int e;
+} jsonw_fp;
+
+static jsonw_fp jsonw_fpmul(jsonw_fp a, jsonw_fp b) {
+  uint64_t hi, lo = jsonw_mul128(a.f, b.f, &hi);
+  return (jsonw_fp){hi + (lo >> 63), a.e + b.e + 64};
+}
+
+// `floor(x * log10(2))`, without shifting negative numbers
+static int jsonw_log10pow2(int x) {
+  return x >= 0 ? x * 78913 >> 18 : -((-x * 78913 + (1 << 18) - 1) >> 18);
+}
+
+// Loitsch's Grisu2, with the digit generation and rounding of RapidJSON: the
+// digits of what reads back as the positive `num`, which are most often the
+// fewest digits that do, times 10 to the `exp`. returns the number of digits
+static int jsonw_grisu2(char digits[17], int *exp, double num) {
+  static const uint64_t pow10[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+      10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+      1000000000000000, 10000000000000000, 100000000000000000,
+      1000000000000000000, 10000000000000000000u};
+  uint64_t bits, frac;
+  memcpy(&bits, &num, sizeof(bits)), frac = bits & (((uint64_t)1 << 52) - 1);
+  jsonw_fp v = {frac, -1074}, plus, minus;
+  if (bits >> 52)
+    v = (jsonw_fp){frac | (uint64_t)1 << 52, (int)(bits >> 52) - 1075};
+
+  // the boundaries halfway to the neighboring `double`s, with the lower one
+  // closer at powers of two
+  plus = (jsonw_fp){v.f << 1 | 1, v.e - 1};
+  while (!(plus.f >> 53))
+    plus.f <<= 1, plus.e--;
+  plus.f <<= 10, plus.e -= 10;
+  minus = v.f == (uint64_t)1 << 52 ? (jsonw_fp){(v.f << 2) - 1, v.e - 2}
+                                   : (jsonw_fp){(v.f << 1) - 1, v.e - 1};
+  minus.f <<= minus.e - plus.e, minus.e = plus.e;
+  int lz = jsonw_clz64(v.f);
+  v.f <<= lz, v.e -= lz;
+
+  // scale by the power of ten that brings the upper boundary's exponent into
+  // [-60, -57], so that its integral part has a few bits at most
+  int q = -jsonw_log10pow2(61 + plus.e);
+  const uint64_t *pow5 = jsonw_pow5[q + 342];
+  long long log2 = q * 217706LL;
+  int e = (log2 >= 0 ? log2 / 65536 : -((-log2 + 65535) / 65536)) - 63;
+  jsonw_fp c = {pow5[0] + (pow5[1] >> 63), (int)e};
+  jsonw_fp w = jsonw_fpmul(v, c), hi = jsonw_fpmul(plus, c);
+  jsonw_fp lo = jsonw_fpmul(minus, c);
+  hi.f--, lo.f++; // stay within the boundaries despite rounding errors
+
+  // generate digits of the upper boundary until they're within `delta` of it
+  int shift = -hi.e, kappa = 0, len = 0;
+  uint64_t one = (uint64_t)1 << shift, delta = hi.f - lo.f, dist = hi.f - w.f;
+  uint64_t p1 = hi.f >> shift, p2 = hi.f & (one - 1), rest = 0, unit = one;
+  *exp = -q;
+  while (kappa < 20 && p1 >= pow10[kappa])
+    kappa++;
+  while (kappa > 0) {
+    uint64_t d = p1 / pow10[kappa - 1];
+    p1 %= pow10[kappa - 1], kappa--;
+    if (d || len)
+      digits[len++] = '0' + d;
+    if ((rest = p1 << shift | p2) <= delta) {
+      unit = pow10[kappa] << shift, *exp += kappa;
+      goto round;
+    }
+  }
+  do {
+    p2 *= 10, delta *= 10, dist *= kappa > -20 ? 10 : 0;
+    char d = p2 >> shift;
+    if (d || len)
+      digits[len++] = '0' + d;
+    p2 &= one - 1, kappa--;
+  } while ((rest = p2) >= delta);
+  *exp += kappa;
+
+round:
+  // nudge the last digit toward `num` while staying within the boundaries
+  while (rest < dist && delta - rest >= unit &&
+         (rest + unit < dist || dist - rest > rest + unit - dist))
+    digits[len - 1]--, rest += unit;
+  return len;
+}
+
+char *jsonw_dtoa(char buf[sizeof("-0.0000012345678901234567")], double num) {
+  uint64_t bits;
+  memcpy(&bits, &num, sizeof(bits));
+  if ((bits >> 52 & 0x7ff) == 0x7ff)
+    return NULL; // infinities and NaNs aren't numbers in JSON
+  if (bits >> 63)
+    *buf++ = '-', num = -num, bits &= ~((uint64_t)1 << 63);
+  if (bits == 0)
+    return *buf++ = '0', *buf = '\0', buf;
+
+  char digits[17];
+  int exp, len = jsonw_grisu2(digits, &exp, num), point = len + exp;
+  if (exp >= 0 && point <= 21) // 1234e7 -> 12340000000
+    memcpy(buf, digits, len), memset(buf + len, '0', exp), buf += point;
+  else if (point > 0 && point <= 21) // 1234e-2 -> 12.34
+    memcpy(buf, digits, point), buf[point] = '.',
+        memcpy(buf + point + 1, digits + point, len - point), buf += len + 1;
+  else if (point > -6 && point <= 0) // 1234e-6 -> 0.001234
+    memcpy(buf, "0.", 2), memset(buf + 2, '0', -point),
+        memcpy(buf + 2 - point, digits, len), buf += 2 - point + len;
+  else { // 1234e30 -> 1.234e33
+    *buf++ = digits[0];
+    if (len > 1)
+      *buf++ = '.', memcpy(buf, digits + 1, len - 1), buf += len - 1;
+    *buf++ = 'e', exp = point - 1;
+    if (exp < 0)
+      *buf++ = '-', exp = -exp;
+    if (exp >= 100)
+      *buf++ = '0' + exp / 100;
+    if (exp >= 10)
+      *buf++ = '0' + exp / 10 % 10;
+    *buf++ = '0' + exp % 10;
+  }
+  return *buf = '\0', buf;
+}
+
+// appends the `len` bytes at `bytes`, handing `buf` to `write` as it fills up
+static jsonw_writer *jsonw_put(jsonw_writer *w, size_t len, char *bytes) {
+  // a buffer with no room never fills up, so there would be nothing to write
+  if (w == NULL || w->size == 0)
+    return NULL;
+  for (size_t room; len > (room = w->size - w->len); w->len = 0) {
+    memcpy(w->buf + w->len, bytes, room), bytes += room, len -= room;
+    if (w->len += room, w->write == NULL || !w->write(w->ctx, w->buf, w->len))
+      return NULL;
+  }
+  return memcpy(w->buf + w->len, bytes, len), w->len += len, w;
+}
+
+// the value separator due before a value, if any
+static jsonw_writer *jsonw_putsep(jsonw_writer *w) {
+  return w && w->sep ? jsonw_put(w, 1, ",") : w;
+}
+
+// after a value, a value separator is due before the next one
+static jsonw_writer *jsonw_putval(bool sep, jsonw_writer *w) {
+  return w && (w->sep = sep, true) ? w : NULL;
+}
+
+static jsonw_writer *jsonw_putstr(char *str, jsonw_writer *w) {
+  w = jsonw_put(w, 1, "\"");
+  // copy runs of characters that need no escaping in bulk
+  for (char *run, esc[sizeof("\\u0000")]; w; str++) {
+    str = jsonw_scanstr(NULL, run = str), w = jsonw_put(w, str - run, run);
+    if (*str == '\0')
+      return jsonw_put(w, 1, "\"");
+    w = jsonw_put(w, jsonw_quote(esc, *str) - esc, esc);
+  }
+  return NULL;
+}
+
+jsonw_writer *jsonw_putbeginarr(jsonw_writer *w) {
+  return jsonw_putval(false, jsonw_put(jsonw_putsep(w), 1, "["));
+}
+jsonw_writer *jsonw_putendarr(jsonw_writer *w) {
+  return jsonw_putval(true, jsonw_put(w, 1, "]"));
+}
+jsonw_writer *jsonw_putbeginobj(jsonw_writer *w) {
+  return jsonw_putval(false, jsonw_put(jsonw_putsep(w), 1, "{"));
+}
+jsonw_writer *jsonw_putendobj(jsonw_writer *w) {
+  return jsonw_putval(true, jsonw_put(w, 1, "}"));
+}
+jsonw_writer *jsonw_putname(char *name, jsonw_writer *w) {
+  return jsonw_putval(false,
+                      jsonw_put(jsonw_putstr(name, jsonw_putsep(w)), 1, ":"));
+}
+jsonw_writer *jsonw_putnull(jsonw_writer *w) {
+  return jsonw_putval(true, jsonw_put(jsonw_putsep(w), 4, "null"));
+}
+jsonw_writer *jsonw_putboolean(bool b, jsonw_writer *w) {
+  return jsonw_putval(
+      true, jsonw_put(jsonw_putsep(w), b ? 4 : 5, b ? "true" : "false"));
+}
+jsonw_writer *jsonw_putnumber(double num, jsonw_writer *w) {
+  char buf[sizeof("-0.0000012345678901234567")], *end = jsonw_dtoa(buf, num);
+  return end ? jsonw_putval(true, jsonw_put(jsonw_putsep(w), end - buf, buf))
+             : NULL;
+}
+jsonw_writer *jsonw_putint64(int64_t num, jsonw_writer *w) {
+  char buf[sizeof("-18446744073709551615")], *b = buf + sizeof(buf);
+  uint64_t mag = num < 0 ? 0 - (uint64_t)num : (uint64_t)num;
+  do
+    *--b = '0' + mag % 10;
+  while (mag /= 10);
+  if (num < 0)
+    *--b = '-';
+  return jsonw_putval(true,
+                      jsonw_put(jsonw_putsep(w), buf + sizeof(buf) - b, b));
+}
+jsonw_writer *jsonw_putuint64(uint64_t num, jsonw_writer *w) {
+  char buf[sizeof("18446744073709551615")], *b = buf + sizeof(buf);
+  do
+    *--b = '0' + num % 10;
+  while (num /= 10);
+  return jsonw_putval(true,
+                      jsonw_put(jsonw_putsep(w), buf + sizeof(buf) - b, b));
+}
+jsonw_writer *jsonw_putstring(char *str, jsonw_writer *w) {
+  return jsonw_putval(true, jsonw_putstr(str, jsonw_putsep(w)));
+}
+
+jsonw_writer *jsonw_flush(jsonw_writer *w) {
+  if (w && w->len && w->write) {
+    if (!w->write(w->ctx, w->buf, w->len))
+      return NULL;
+    w->len = 0;
+  }
+  return w;
+}
+
+// structural index
+
+// 64-bit masks of the quotes, backslashes, opening and closing brackets,
+// commas and NULs in the 64-byte `block`
+static void jsonw_classify(uint64_t *quote, uint64_t *bslash, uint64_t *open,
+                           uint64_t *close, uint64_t *comma, uint64_t *nul,
+                           char *block) {
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+  *quote = *bslash = *open = *close = *comma = *nul = 0;
+  for (int i = 0; i < 64; i += 16) {
+    __m128i v = _mm_loadu_si128((__m128i *)(block + i));
+    // '[' and ']' are '{' and '}' with bit 5 cleared
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+#define MASK(CMP) ((uint64_t)(uint16_t)_mm_movemask_epi8(CMP) << i)
+    *quote |= MASK(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    *bslash |= MASK(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    *open |= MASK(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')));
+    *close |= MASK(_mm_cmpeq_epi8(lower, _mm_set1_epi8('}')));
+    *comma |= MASK(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+    *nul |= MASK(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+#undef MASK
+  }
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+  static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                      1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t w = vld1q_u8(weights), m[6][4];
+  for (int i = 0; i < 4; i++) {
+    uint8x16_t v = vld1q_u8((uint8_t *)block + 16 * i);
+    uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+    m[0][i] = vandq_u8(vceqq_u8(v, vdupq_n_u8('"')), w);
+    m[1][i] = vandq_u8(vceqq_u8(v, vdupq_n_u8('\\')), w);
+    m[2][i] = vandq_u8(vceqq_u8(lower, vdupq_n_u8('{')), w);
+    m[3][i] = vandq_u8(vceqq_u8(lower, vdupq_n_u8('}')), w);
+    m[4][i] = vandq_u8(vceqq_u8(v, vdupq_n_u8(',')), w);
+    m[5][i] = vandq_u8(vceqq_u8(v, vdupq_n_u8(0)), w);
+  }
+  // pairwise additions fold each byte's weight into a 64-bit movemask
+  uint64_t *out[6] = {quote, bslash, open, close, comma, nul};
+  for (int k = 0; k < 6; k++) {
+    uint8x16_t s = vpaddq_u8(vpaddq_u8(m[k][0], m[k][1]),
+                             vpaddq_u8(m[k][2], m[k][3]));
+    s = vpaddq_u8(s, s);
+    *out[k] = vgetq_lane_u64(vreinterpretq_u64_u8(s), 0);
+  }
+#else
+  *quote = *bslash = *open = *close = *comma = *nul = 0;
+  for (int i = 0; i < 64; i++) {
+    *quote |= (uint64_t)(block[i] == '"') << i;
+    *bslash |= (uint64_t)(block[i] == '\\') << i;
+    *open |= (uint64_t)((block[i] | 0x20) == '{') << i;
+    *close |= (uint64_t)((block[i] | 0x20) == '}') << i;
+    *comma |= (uint64_t)(block[i] == ',') << i;
+    *nul |= (uint64_t)(block[i] == '\0') << i;
+  }
+#endif
+}
+
+static int jsonw_ctz64(uint64_t x) {
+#ifdef __GNUC__
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  for (; !(x & 1); x >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+// the characters escaped by the backslashes in `bslash`: those that follow an
+// odd-length run of backslashes. `carry` is set if the last backslash of the
+// previous block escapes the first character of this one
+static uint64_t jsonw_escaped(uint64_t bslash, uint64_t *carry) {
+  const uint64_t even = 0x5555555555555555;
+  bslash &= ~*carry;
+  uint64_t follows = bslash << 1 | *carry;
+  uint64_t odd_starts = bslash & ~even & ~follows;
+  // adding a run starting on an odd bit carries out of it on an even bit
+  uint64_t even_ends = odd_starts + bslash;
+  *carry = even_ends < bslash;
+  return (even ^ even_ends << 1) & follows;
+}
+
+// bit i of the result is the parity of bits 0 through i of `x`
+static uint64_t jsonw_prefix_xor(uint64_t x) {
+#if defined(__GNUC__) && defined(__PCLMUL__)
+  // a carry-less multiplication by all ones sums every prefix at once
+  __m128i ones = _mm_set1_epi8(-1);
+  return _mm_cvtsi128_si64(
+      _mm_clmulepi64_si128(_mm_set_epi64x(0, (int64_t)x), ones, 0));
+#else
+  for (int i = 1; i < 64; i <<= 1)
+    x ^= x << i;
+  return x;
+#endif
+}
+
+bool jsonw_structure(jsonw_sidx *sidx, jsonw_mark *marks, size_t cap,
+                     char *end, char *json) {
+  if (json == NULL)
+    return false;
+  if (end == NULL)
+    end = json + strlen(json);
+  if (end - json > UINT32_MAX)
+    return false;
+
+  *sidx = (jsonw_sidx){json, end, marks, 0, 0};
+  uint32_t stack[JSONW_MAX_DEPTH]; // marks of the open brackets
+  size_t depth = 0;
+  uint64_t escape = 0, in_string = 0;
+
+  for (char *block = json; block < end; block += 64) {
+    // pad the last block with whitespace rather than reading past `end`
+    char pad[64], *b = block;
+    if (end - block < 64)
+      memset(pad, ' ', 64), memcpy(pad, block, end - block), b = pad;
+
+    uint64_t quote, bslash, opens, closes, commas, nuls;
+    jsonw_classify(&quote, &bslash, &opens, &closes, &commas, &nuls, b);
+    quote &= ~jsonw_escaped(bslash, &escape);
+    // a string spans from its opening quote up to its closing quote
+    in_string = jsonw_prefix_xor(quote) ^ in_string;
+    uint64_t structural = (opens | closes | commas) & ~in_string;
+    in_string = 0 - (in_string >> 63);
+
+    for (; structural; structural &= structural - 1) {
+      uint32_t off = block - json + jsonw_ctz64(structural);
+      char chr = json[off];
+      if (chr == ',') {
+        // count separators in the link of the open mark until it closes
+        if (depth)
+          marks[stack[depth - 1]].link++;
+        continue;
+      }
+
+      if (sidx->len == cap)
+        return false;
+      jsonw_mark *mark = marks + sidx->len;
+      if (chr == '[' || chr == '{') {
+        if (depth == JSONW_MAX_DEPTH)
+          return false;
+        *mark = (jsonw_mark){off, 0}, stack[depth++] = sidx->len++;
+        continue;
+      }
+
+      // '[' and ']', and '{' and '}', are two code points apart
+      jsonw_mark *open = depth ? marks + stack[depth - 1] : NULL;
+      if (open == NULL || json[open->off] + 2 != chr)
+        return false;
+      // an empty structure has no values, otherwise one more than separators
+      char *first = jsonw_ws_n(end, json + open->off + 1);
+      *mark = (jsonw_mark){off, open->link + (first != json + off)};
+      open->link = sidx->len++, depth--;
+    }
+  }
+
+  return depth == 0 && in_string == 0;
+}
+
+// the mark for the bracket at `json`, or `NULL` if there is none. lookups in
+// text order hit the hint or the mark after it
+static jsonw_mark *jsonw_marked(jsonw_sidx *sidx, char *json) {
+  size_t off = json - sidx->json, lo = 0, hi = sidx->len;
+  for (size_t i = sidx->hint; i < sidx->hint + 2 && i < sidx->len; i++)
+    if (sidx->marks[i].off == off)
+      return sidx->marks + (sidx->hint = i);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (sidx->marks[mid].off < off)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo < sidx->len && sidx->marks[lo].off == off)
+    return sidx->marks + (sidx->hint = lo);
+  return NULL;
+}
+
+// skips the structured type whose opening bracket is at `json`
+static char *jsonw_jump(size_t *len, jsonw_sidx *sidx, char *json) {
+  jsonw_mark *mark = jsonw_marked(sidx, json);
+  if (mark == NULL)
+    return NULL;
+  jsonw_mark *close = sidx->marks + (sidx->hint = mark->link);
+  if (len)
+    *len = close->link;
+  return jsonw_ws_n(sidx->end, sidx->json + close->off + 1);
+}
+
+char *jsonw_array_i(size_t *len, jsonw_sidx *sidx, char *json) {
+  char *end = sidx->end;
+  json = jsonw_ws_n(end, json);
+  return json && AT(json) == '[' ? jsonw_jump(len, sidx, json) : NULL;
+}
+
+char *jsonw_object_i(size_t *len, jsonw_sidx *sidx, char *json) {
+  char *end = sidx->end;
+  json = jsonw_ws_n(end, json);
+  return json && AT(json) == '{' ? jsonw_jump(len, sidx, json) : NULL;
+}
+
+char *jsonw_value_i(jsonw_ty *type, jsonw_sidx *sidx, char *json) {
+  OUT_PARAM(jsonw_ty, type);
+  char *end = sidx->end, *j = NULL, *ws = jsonw_ws_n(end, json);
+  switch (ws ? AT(ws) : '\0') {
+  case '[':
+    (j = jsonw_jump(NULL, sidx, ws)) && (*type = JSONW_ARRAY);
+    break;
+  case '{':
+    (j = jsonw_jump(NULL, sidx, ws)) && (*type = JSONW_OBJECT);
+    break;
+  default:
+    // primitives never start with whitespace
+    j = ws == json ? jsonw_primitive_n(type, end, json) : NULL;
+  }
+  return j;
+}
+
+char *jsonw_element_i(jsonw_sidx *sidx, char *json) {
+  return jsonw_valuesep_n(sidx->end, jsonw_value_i(NULL, sidx, json));
+}
+
+char *jsonw_member_i(jsonw_sidx *sidx, char *json) {
+  return jsonw_element_i(sidx, jsonw_name_n(sidx->end, json));
+}
+
+char *jsonw_index_i(size_t idx, jsonw_sidx *sidx, char *json) {
+  while (idx--)
+    json = jsonw_element_i(sidx, json);
+  return json;
+}
+
+char *jsonw_find_i(char *name, jsonw_sidx *sidx, char *json) {
+  char *end = sidx->end;
+  do
+    if (jsonw_strcmp_n(name, end, jsonw_beginstr_n(end, json)) == 0)
+      return json;
+  while (json = jsonw_member_i(sidx, json));
+  return NULL;
+}
+
+char *jsonw_lookup_i(char *name, jsonw_sidx *sidx, char *json) {
+  return jsonw_name_n(sidx->end, jsonw_find_i(name, sidx, json));
+}
+
+size_t jsonw_split_i(char **elems, size_t n, jsonw_sidx *sidx, char *json) {
+  char *end = sidx->end;
+  jsonw_mark *open, *close;
+  if ((json = jsonw_ws_n(end, json)) == NULL || AT(json) != '[' ||
+      (open = jsonw_marked(sidx, json)) == NULL)
+    return 0;
+  close = sidx->marks + open->link;
+  char *first = jsonw_ws_n(end, json + 1);
+  if (first == sidx->json + close->off || n == 0)
+    return 0;
+
+  // hop from each structured element to the next through the closing marks.
+  // the rest of the text is the size, as in `jsonw_split_n`
+  size_t len = 1, base = first - sidx->json, size = end - first;
+  elems[0] = first;
+  for (jsonw_mark *mark = open + 1; mark != close && len < n;
+       mark = sidx->marks + mark->link + 1)
+    if ((size_t)(mark->off - base) * n >= len * size)
+      elems[len++] = sidx->json + mark->off;
+  return len;
+}
+
+// tapes
+
+// compares two names the way `jsonw_strcmp` compares a C string to one, from
+// their contents on
+static int jsonw_namecmp(char *end, char *a, char *b) {
+  char ca, cb;
+  do
+    ca = cb = '\0', a = jsonw_character_n(&ca, end, a),
+    b = jsonw_character_n(&cb, end, b);
+  while (ca && ca == cb);
+  return ca - cb;
+}
+
+static bool jsonw_slotless(jsonw_tape *tape, jsonw_slot *a, jsonw_slot *b) {
+  int cmp = jsonw_namecmp(tape->end, tape->json + a->name + 1,
+                          tape->json + b->name + 1);
+  return cmp < 0 || cmp == 0 && a->ent < b->ent;
+}
+
+// sifts slot `i` down the heap of the `n` slots at `slots`
+static void jsonw_sift(jsonw_tape *tape, jsonw_slot *slots, size_t i,
+                       size_t n) {
+  for (size_t c; (c = 2 * i + 1) < n; i = c) {
+    c += c + 1 < n && jsonw_slotless(tape, slots + c, slots + c + 1);
+    if (!jsonw_slotless(tape, slots + i, slots + c))
+      break;
+    jsonw_slot swap = slots[i];
+    slots[i] = slots[c], slots[c] = swap;
+  }
+}
+
+// heapsort needs no memory of its own, and the order of slots is total
+static void jsonw_sortslots(jsonw_tape *tape, jsonw_slot *slots, size_t n) {
+  for (size_t i = n / 2; i-- > 0;)
+    jsonw_sift(tape, slots, i, n);
+  while (n-- > 1) {
+    jsonw_slot max = slots[0];
+    slots[0] = slots[n], slots[n] = max;
+    jsonw_sift(tape, slots, 0, n);
+  }
+}
+
+char *jsonw_build(jsonw_tape *tape, char *end, char *json) {
+  if (json == NULL)
+    return NULL;
+
+  // the names of the members of open objects are stacked at the back of
+  // `slots` down to `top`, and moved to the front once their object closes
+  uint32_t stack[JSONW_MAX_DEPTH]; // entries of the open arrays and objects
+  size_t depth = 0, top = tape->slotcap;
+  jsonw_entry *open = NULL;
+  tape->json = json, tape->end = end;
+  tape->len = tape->slotlen = tape->hint = 0;
+
+#define IN_OBJECT (open->type == JSONW_OBJECT)
+#define NAME                                                                   \
+  do {                                                                         \
+    char *name = json;                                                         \
+    if ((json = jsonw_name_n(end, json)) == NULL)                              \
+      return NULL;                                                             \
+    if (tape->slots && top == tape->slotlen)                                   \
+      return NULL;                                                             \
+    if (tape->slots)                                                           \
+      tape->slots[--top] = (jsonw_slot){name - tape->json, tape->len};         \
+  } while (0)
+
+  json = jsonw_ws_n(end, json);
+  while (1) {
+    // a value starts at `json`
+    if (tape->len == tape->cap || json - tape->json > UINT32_MAX)
+      return NULL;
+    jsonw_entry *ent = tape->ents + tape->len++;
+    *ent = (jsonw_entry){.off = json - tape->json, .size = 1,
+                         .table = UINT32_MAX};
+    if (AT(json) == '[' || AT(json) == '{') {
+      if (depth == JSONW_MAX_DEPTH)
+        return NULL;
+      ent->type = *json == '{' ? JSONW_OBJECT : JSONW_ARRAY;
+      stack[depth++] = ent - tape->ents, open = ent;
+      json = jsonw_ws_n(end, json + 1);
+      if (AT(json) == (IN_OBJECT ? '}' : ']'))
+        goto close;
+      if (IN_OBJECT)
+        NAME;
+      continue; // to the first value
+    }
+
+    if ((json = jsonw_primitive_n(&ent->type, end, json)) == NULL)
+      return NULL;
+
+    while (1) {
+      // a value was just parsed, an element or member of `open` if any
+      if (depth == 0)
+        return jsonw_ws_n(end, json);
+      open->len++, json = jsonw_ws_n(end, json);
+      if (AT(json) == ',') {
+        json = jsonw_ws_n(end, json + 1);
+        if (IN_OBJECT)
+          NAME;
+        break; // to the next value
+      }
+
+      if (AT(json) != (IN_OBJECT ? '}' : ']'))
+        return NULL;
+    close:
+      json++, open->size = tape->ents + tape->len - open;
+      if (IN_OBJECT && tape->slots) {
+        jsonw_slot *names = tape->slots + top;
+        jsonw_sortslots(tape, names, open->len);
+        memmove(tape->slots + tape->slotlen, names,
+                open->len * sizeof(*names));
+        open->table = tape->slotlen;
+        tape->slotlen += open->len, top += open->len;
+      }
+      depth--, open = depth ? tape->ents + stack[depth - 1] : NULL;
+    }
+  }
+
+#undef NAME
+#undef IN_OBJECT
+}
+
+jsonw_entry *jsonw_entryat(jsonw_tape *tape, char *json) {
+  if ((json = jsonw_ws_n(tape->end, json)) == NULL)
+    return NULL;
+  // lookups in text order hit the hint or the entry after it
+  size_t off = json - tape->json, lo = 0, hi = tape->len;
+  for (size_t i = tape->hint; i < tape->hint + 2 && i < tape->len; i++)
+    if (tape->ents[i].off == off)
+      return tape->ents + (tape->hint = i);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (tape->ents[mid].off < off)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo < tape->len && tape->ents[lo].off == off)
+    return tape->ents + (tape->hint = lo);
+  return NULL;
+}
+
+char *jsonw_index_t(size_t idx, jsonw_tape *tape, char *json) {
+  jsonw_entry *ent = jsonw_entryat(tape, json);
+  if (ent == NULL || ent->type != JSONW_ARRAY || idx >= ent->len)
+    return NULL;
+  // the next element's entry follows the last entry of the previous one
+  for (ent++; idx--;)
+    ent += ent->size;
+  tape->hint = ent - tape->ents;
+  return tape->json + ent->off;
+}
+
+char *jsonw_lookup_t(char *name, jsonw_tape *tape, char *json) {
+  char *end = tape->end;
+  jsonw_entry *ent = jsonw_entryat(tape, json);
+  if (ent == NULL || ent->type != JSONW_OBJECT)
+    return NULL;
+  if (ent->table == UINT32_MAX)
+    return jsonw_lookup_n(name, end,
+                          jsonw_beginobj_n(end, tape->json + ent->off));
+
+  // the first slot not ordered before `name` is its first match, if any
+  jsonw_slot *slots = tape->slots + ent->table;
+  size_t lo = 0, hi = ent->len;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (jsonw_strcmp_n(name, end, tape->json + slots[mid].name + 1) > 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo == ent->len ||
+      jsonw_strcmp_n(name, end, tape->json + slots[lo].name + 1) != 0)
+    return NULL;
+  tape->hint = slots[lo].ent;
+  return tape->json + tape->ents[slots[lo].ent].off;
+}
+
+// unchecked parsers
+
+static int jsonw_popcount64(uint64_t x) {
+#ifdef __GNUC__
+  return __builtin_popcountll(x);
+#else
+  int n = 0;
+  for (; x; x &= x - 1)
+    n++;
+  return n;
+#endif
+}
+
+// skips the structured type whose opening bracket is at `json` by counting
+// the brackets outside of string literals 64 bytes at a time. without an
+// `end`, blocks are loaded from aligned addresses like in `jsonw_scanstr`
+static char *jsonw_skip(char *end, char *json) {
+  char *block = end ? json : (char *)((uintptr_t)json & ~(uintptr_t)63);
+  uint64_t escape = 0, in_string = 0, after = ~(uint64_t)0 << (json - block);
+  size_t depth = 0;
+
+  for (; end == NULL || block < end; block += 64, after = ~(uint64_t)0) {
+    char pad[64], *b = block;
+    if (end && end - block < 64)
+      memset(pad, ' ', 64), memcpy(pad, block, end - block), b = pad;
+
+    uint64_t quote, bslash, opens, closes, commas, nuls;
+    jsonw_classify(&quote, &bslash, &opens, &closes, &commas, &nuls, b);
+    quote &= ~jsonw_escaped(bslash & after, &escape) & after;
+    in_string = jsonw_prefix_xor(quote) ^ in_string;
+    // without an `end`, the text stops at its terminating NUL, and so do the
+    // blocks loaded
+    nuls = end ? 0 : nuls & after;
+    uint64_t before = nuls ? (nuls & -nuls) - 1 : ~(uint64_t)0;
+    opens &= ~in_string & after & before, closes &= ~in_string & after & before;
+    in_string = 0 - (in_string >> 63);
+
+    // only look for the closing bracket in blocks it can be in
+    int n = jsonw_popcount64(closes);
+    if (depth > n && !nuls) {
+      depth += jsonw_popcount64(opens) - n;
+      continue;
+    }
+    for (uint64_t m = opens | closes; m; m &= m - 1) {
+      int i = jsonw_ctz64(m);
+      if (opens >> i & 1)
+        depth++;
+      else if (--depth == 0)
+        return jsonw_ws_n(end, block + i + 1);
+    }
+    if (nuls)
+      return NULL;
+  }
+  return NULL;
+}
+
+// skips the rest of the string literal whose contents start at `json`
+static char *jsonw_skipstr(char *end, char *json) {
+  while ((json = jsonw_scanstr(end, json)) != end && *json != '"' && *json)
+    json += *json == '\\' && json + 1 != end ? 2 : 1;
+  return AT(json) == '"' ? json + 1 : NULL;
+}
+
+char *jsonw_value_u(jsonw_ty *type, char *end, char *json) {
+  OUT_PARAM(jsonw_ty, type);
+  char *ws = jsonw_ws_n(end, json);
+  switch (ws ? AT(ws) : '\0') {
+  case '[':
+    return (json = jsonw_skip(end, ws)) && (*type = JSONW_ARRAY), json;
+  case '{':
+    return (json = jsonw_skip(end, ws)) && (*type = JSONW_OBJECT), json;
+  }
+
+  // primitives never start with whitespace
+  if (ws == NULL || ws != json)
+    return NULL;
+  switch (AT(json)) {
+  case '"':
+    return (json = jsonw_skipstr(end, json + 1)) && (*type = JSONW_STRING),
+           json;
+  case 'n':
+    *type = JSONW_NULL;
+    break;
+  case 't':
+  case 'f':
+    *type = JSONW_BOOLEAN;
+    break;
+  case '-':
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    *type = JSONW_NUMBER;
+    break;
+  default:
+    return NULL;
+  }
+  // literals and numbers run up to the next delimiter
+  while (json != end && (unsigned char)*json > ' ' && *json != ',' &&
+         *json != ']' && *json != '}')
+    json++;
+  return json;
+}
+
+char *jsonw_element_u(char *end, char *json) {
+  return jsonw_valuesep_n(end, jsonw_value_u(NULL, end, json));
+}
+
+char *jsonw_member_u(char *end, char *json) {
+  json = jsonw_beginstr_n(end, json);
+  json = json ? jsonw_namesep_n(end, jsonw_skipstr(end, json)) : NULL;
+  return jsonw_element_u(end, json);
+}
+
+char *jsonw_index_u(size_t idx, char *end, char *json) {
+  while (idx--)
+    json = jsonw_element_u(end, json);
+  return json;
+}
+
+char *jsonw_find_u(char *name, char *end, char *json) {
+  do
+    if (jsonw_strcmp_n(name, end, jsonw_beginstr_n(end, json)) == 0)
+      return json;
+  while (json = jsonw_member_u(end, json));
+  return NULL;
+}
+
+char *jsonw_lookup_u(char *name, char *end, char *json) {
+  json = jsonw_beginstr_n(end, jsonw_find_u(name, end, json));
+  return json ? jsonw_namesep_n(end, jsonw_skipstr(end, json)) : NULL;
+}
+
+// path queries
+
+// programs are sequences of steps, each an opcode and its operand, ended by
+// a NUL opcode
+#define OP_KEY 'k'   // member of an object, followed by a `size_t` length and
+                     // the NUL-terminated name of that length
+#define OP_INDEX 'i' // element of an array, followed by a `size_t` subscript
+#define OP_MEMBS '*' // any member of an object
+#define OP_ELEMS '[' // any element of an array
+
+char *jsonw_compile(char *prog, size_t size, char *path) {
+  char *end = prog + size;
+  bool key = *path != '[' && *path != '\0'; // a leading key has no '.'
+  while (key || *path) {
+    size_t idx = 0;
+    if (!key && *path == '.')
+      key = true, path++;
+    if (key && path[0] == '*' && (path[1] == '\0' || strchr(".[", path[1]))) {
+      if (end - prog < 1)
+        return NULL;
+      *prog++ = OP_MEMBS, path++;
+    } else if (key) {
+      // keys run up to the next unescaped '.' or '['
+      char *name = prog + 1 + sizeof(idx);
+      if (end - name < 1)
+        return NULL;
+      for (*prog = OP_KEY, prog = name; *path && *path != '.' && *path != '[';
+           path++) {
+        if (*path == '\\' && *++path == '\0')
+          return NULL;
+        if (end - prog < 2)
+          return NULL;
+        *prog++ = *path;
+      }
+      idx = prog - name, *prog++ = '\0';
+      memcpy(name - sizeof(idx), &idx, sizeof(idx));
+    } else if (path[0] == '[' && path[1] == '*' && path[2] == ']') {
+      if (end - prog < 1)
+        return NULL;
+      *prog++ = OP_ELEMS, path += 3;
+    } else if (*path++ == '[' && ISDIGIT(*path)) {
+      for (; ISDIGIT(*path); path++)
+        if (idx > (SIZE_MAX - (*path - '0')) / 10)
+          return NULL;
+        else
+          idx = idx * 10 + (*path - '0');
+      if (*path++ != ']' || end - prog < 1 + sizeof(idx))
+        return NULL;
+      *prog++ = OP_INDEX, memcpy(prog, &idx, sizeof(idx)), prog += sizeof(idx);
+    } else
+      return NULL;
+    key = false;
+  }
+  if (end - prog < 1)
+    return NULL;
+  return *prog++ = '\0', prog;
+}
+
+// the step after the one at `pc`
+static char *jsonw_nextop(char *pc) {
+  size_t len;
+  if (*pc == OP_KEY)
+    return memcpy(&len, pc + 1, sizeof(len)), pc + 1 + sizeof(len) + len + 1;
+  return *pc == OP_INDEX ? pc + 1 + sizeof(size_t) : pc + 1;
+}
+
+typedef struct {
+  jsonw_match *match;
+  void *ctx;
+  char *end;
+} jsonw_walker;
+
+// parses the value `json`, with `pcs` the next steps of the paths in `active`,
+// descending only into members and elements that some path continues into
+static char *jsonw_walk(jsonw_walker *w, uint64_t active, char **pcs,
+                        char *json) {
+  char *end = w->end, *next[JSONW_MAX_PATHS];
+  if (json == NULL)
+    return NULL;
+  for (uint64_t m = active; m; m &= m - 1)
+    if (*pcs[jsonw_ctz64(m)] == '\0')
+      w->match(w->ctx, jsonw_ctz64(m), json),
+          active &= ~((uint64_t)1 << jsonw_ctz64(m));
+  if (active == 0 || AT(json) != '[' && AT(json) != '{')
+    return jsonw_value_n(NULL, end, json);
+
+  bool obj = *json == '{';
+  json = jsonw_ws_n(end, json + 1);
+  if (AT(json) == (obj ? '}' : ']'))
+    return jsonw_ws_n(end, json + 1);
+  for (size_t idx = 0;; idx++) {
+    char *val = obj ? jsonw_name_n(end, json) : json;
+    if (val == NULL)
+      return NULL;
+    // the paths whose next step matches this member or element. names
+    // without escapes are their own raw bytes
+    char *quote = obj ? jsonw_scanstr(end, json + 1) : NULL;
+    size_t raw = quote && AT(quote) == '"' ? quote - json - 1 : SIZE_MAX;
+    uint64_t sub = 0;
+    for (uint64_t m = active; m; m &= m - 1) {
+      int i = jsonw_ctz64(m);
+      size_t step;
+      bool hit = *pcs[i] == (obj ? OP_MEMBS : OP_ELEMS);
+      char *name = pcs[i] + 1 + sizeof(step);
+      if (obj && *pcs[i] == OP_KEY)
+        hit = raw != SIZE_MAX
+                  ? (memcpy(&step, pcs[i] + 1, sizeof(step)), step == raw) &&
+                        memcmp(name, json + 1, raw) == 0
+                  : jsonw_strcmp_n(name, end, json + 1) == 0;
+      else if (!obj && *pcs[i] == OP_INDEX)
+        hit = (memcpy(&step, pcs[i] + 1, sizeof(step)), step == idx);
+      if (hit)
+        sub |= (uint64_t)1 << i, next[i] = jsonw_nextop(pcs[i]);
+    }
+    json = sub ? jsonw_walk(w, sub, next, val) : jsonw_value_n(NULL, end, val);
+    if ((json = jsonw_ws_n(end, json)) == NULL || AT(json) != ',')
+      break;
+    json = jsonw_ws_n(end, json + 1);
+  }
+  return obj ? jsonw_endobj_n(end, json) : jsonw_endarr_n(end, json);
+}
+
+char *jsonw_queryall_n(jsonw_match *match, void *ctx, char **progs, size_t n,
+                       char *end, char *json) {
+  jsonw_walker w = {match, ctx, end};
+  if (n > JSONW_MAX_PATHS)
+    return NULL;
+  uint64_t active = n == 64 ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1;
+  return jsonw_walk(&w, active, progs, jsonw_ws_n(end, json));
+}
+
+// records the first match of each path
+static void jsonw_first(void *ctx, size_t path, char *json) {
+  char **found = ctx;
+  if (found[path] == NULL)
+    found[path] = json;
+}
+
+char *jsonw_query_n(char **vals, char **progs, size_t n, char *end,
+                    char *json) {
+  // `vals` are only written to once the whole value has parsed
+  char *found[JSONW_MAX_PATHS] = {NULL};
+  if ((json = jsonw_queryall_n(jsonw_first, found, progs, n, end, json)))
+    for (size_t i = 0; i < n; i++)
+      if (found[i])
+        vals[i] = found[i];
+  return json;
+}
+
+#undef OP_KEY
+#undef OP_INDEX
+#undef OP_MEMBS
+#undef OP_ELEMS
+
+// minification
+
+// 64-bit mask of the whitespace in the 64-byte `block`, like `jsonw_classify`
+static uint64_t jsonw_wsmask(char *block) {
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+  uint64_t ws = 0;
+  for (int i = 0; i < 64; i += 16) {
+    __m128i v = _mm_loadu_si128((__m128i *)(block + i));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                     _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+    ws |= (uint64_t)(uint16_t)_mm_movemask_epi8(m) << i;
+  }
+  return ws;
+#elif defined(__GNUC__) && defined(__ARM_NEON) && defined(__aarch64__)
+  static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                      1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t w = vld1q_u8(weights), m[4];
+  for (int i = 0; i < 4; i++) {
+    uint8x16_t v = vld1q_u8((uint8_t *)block + 16 * i);
+    m[i] = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')),
+                             vceqq_u8(v, vdupq_n_u8('\t'))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')),
+                             vceqq_u8(v, vdupq_n_u8('\r'))));
+    m[i] = vandq_u8(m[i], w);
+  }
+  uint8x16_t s = vpaddq_u8(vpaddq_u8(m[0], m[1]), vpaddq_u8(m[2], m[3]));
+  s = vpaddq_u8(s, s);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(s), 0);
+#else
+  uint64_t ws = 0;
+  for (int i = 0; i < 64; i++)
+    ws |= (uint64_t)(block[i] == ' ' || block[i] == '\t' || block[i] == '\n' ||
+                     block[i] == '\r')
+          << i;
+  return ws;
+#endif
+}
+
+// appends the bytes of the 64-byte `block` selected by `keep` to `out`
+static char *jsonw_compact(char *out, uint64_t keep, char *block) {
+  // move runs of kept bytes in bulk. adding its lowest one to `keep` clears
+  // its lowest run of ones
+  for (uint64_t low; keep; keep &= keep + low) {
+    int i = jsonw_ctz64(low = keep & (0 - keep)), run = 64 - i;
+    if (~keep >> i)
+      run = jsonw_ctz64(~keep >> i);
+    memmove(out, block + i, run), out += run;
+  }
+  return out;
+}
+
+char *jsonw_minify_n(char *end, char *json) {
+  if (json == NULL)
+    return NULL;
+  char *out = json;
+  uint64_t escape = 0, in_string = 0;
+
+  for (char *block = json; block < end; block += 64) {
+    char pad[64], *b = block;
+    uint64_t keep = ~(uint64_t)0;
+    if (end - block < 64)
+      memset(pad, ' ', 64), memcpy(pad, block, end - block), b = pad,
+          keep = ((uint64_t)1 << (end - block)) - 1;
+
+    uint64_t quote, bslash, opens, closes, commas, nuls;
+    jsonw_classify(&quote, &bslash, &opens, &closes, &commas, &nuls, b);
+    quote &= ~jsonw_escaped(bslash, &escape) & keep;
+    in_string = jsonw_prefix_xor(quote) ^ in_string;
+    keep &= ~(jsonw_wsmask(b) & ~in_string);
+    in_string = 0 - (in_string >> 63);
+    // everything before `block` is read, so writing behind it is safe
+    out = jsonw_compact(out, keep, b);
+  }
+  return out;
+}
+
+// streaming
+
+enum {
+  STREAM_VALUE,       // expecting a value
+  STREAM_FIRST_VALUE, // expecting a value or ']'
+  STREAM_NAME,        // expecting a name
+  STREAM_FIRST_NAME,  // expecting a name or '}'
+  STREAM_NAMESEP,     // expecting ':'
+  STREAM_AFTER,       // expecting ',' or a closing bracket, or the end of text
+  STREAM_STRING,      // within a string literal
+  STREAM_ESCAPE,      // within an escape sequence, buffered in `tok`
+  STREAM_TOKEN,       // within a literal or number, buffered in `tok`
+  STREAM_FAILED,      // a parse failure occurred
+};
+
+// whether the partial token `tok` can still become a literal or a number
+static bool jsonw_viable(char *tok, size_t len) {
+  char buf[sizeof(((jsonw_stream *)0)->tok) + 1];
+  char *lits[] = {"true", "false", "null"};
+  for (int i = 0; i < 3; i++)
+    if (len <= strlen(lits[i]) && memcmp(tok, lits[i], len) == 0)
+      return true;
+  // prefixes of numbers are numbers once at most one more digit is appended
+  memcpy(buf, tok, len), buf[len] = '0';
+  return jsonw_number_n(NULL, buf + len, buf) == buf + len ||
+         jsonw_number_n(NULL, buf + len + 1, buf) == buf + len + 1;
+}
+
+char *jsonw_feed(jsonw_stream *st, char *end, char *json) {
+  if (json == NULL || st->state == STREAM_FAILED)
+    return NULL;
+
+  bool eof = json == end;
+  char *j;
+
+#define IN_OBJECT (st->stack[(st->depth - 1) / 8] >> (st->depth - 1) % 8 & 1)
+#define FAIL return st->state = STREAM_FAILED, NULL
+#define MORE return eof ? (st->state = STREAM_FAILED, NULL) : end
+
+  while (1)
+    switch (st->state) {
+    case STREAM_VALUE:
+    case STREAM_FIRST_VALUE:
+      if ((json = jsonw_ws_n(end, json)) == end)
+        MORE;
+      if (*json == '[' || *json == '{') {
+        if (st->depth == JSONW_MAX_DEPTH)
+          FAIL;
+        st->stack[st->depth / 8] &= ~(1 << st->depth % 8);
+        st->stack[st->depth / 8] |= (*json == '{') << st->depth % 8;
+        st->depth++, json++;
+        STAT_DEPTH(st->depth);
+        st->state = IN_OBJECT ? STREAM_FIRST_NAME : STREAM_FIRST_VALUE;
+      } else if (st->state == STREAM_FIRST_VALUE && *json == ']')
+        st->depth--, json++, st->state = STREAM_AFTER;
+      else if (*json == '"')
+        st->name = false, json++, st->state = STREAM_STRING;
+      else if ((j = jsonw_primitive_n(NULL, end, json)) && j != end)
+        // the token ends within the chunk, so it need not be buffered
+        json = j, st->state = STREAM_AFTER;
+      else
+        st->len = 0, st->state = STREAM_TOKEN;
+      break;
+
+    case STREAM_NAME:
+    case STREAM_FIRST_NAME:
+      if ((json = jsonw_ws_n(end, json)) == end)
+        MORE;
+      if (st->state == STREAM_FIRST_NAME && *json == '}')
+        st->depth--, json++, st->state = STREAM_AFTER;
+      else if (*json == '"')
+        st->name = true, json++, st->state = STREAM_STRING;
+      else
+        FAIL;
+      break;
+
+    case STREAM_NAMESEP:
+      if ((json = jsonw_ws_n(end, json)) == end)
+        MORE;
+      if (*json != ':')
+        FAIL;
+      json++, st->state = STREAM_VALUE;
+      break;
+
+    case STREAM_AFTER:
+      if ((json = jsonw_ws_n(end, json)) == end && st->depth == 0)
+        return end;
+      if (json == end)
+        MORE;
+      if (st->depth == 0)
+        return json;
+      if (*json == ',')
+        json++, st->state = IN_OBJECT ? STREAM_NAME : STREAM_VALUE;
+      else if (*json == (IN_OBJECT ? '}' : ']'))
+        st->depth--, json++;
+      else
+        FAIL;
+      break;
+
+    case STREAM_STRING:
+      json = jsonw_scanstr(end, j = json);
+#ifdef JSONW_VALIDATE_UTF8
+      // sequences cut short by the end of a chunk continue into the next one,
+      // but not past a quote or an escape
+      if (!jsonw_utf8resume(st->utf8, json, j) || json != end && st->utf8[0])
+        FAIL;
+#endif
+      if (json == end)
+        MORE;
+      if (*json == '"')
+        json++, st->state = st->name ? STREAM_NAMESEP : STREAM_AFTER;
+      else if (*json != '\\')
+        FAIL;
+      else if (j = jsonw_character_n(NULL, end, json))
+        json = j;
+      else if (end - json < sizeof("\\u0000") - 1)
+        memcpy(st->tok, json, st->len = end - json), json = end,
+            st->state = STREAM_ESCAPE;
+      else
+        FAIL;
+      break;
+
+    case STREAM_ESCAPE:
+      // complete the escape sequence a character at a time
+      while (st->state == STREAM_ESCAPE) {
+        if (st->len == sizeof("\\u0000") - 1)
+          FAIL;
+        if (json == end)
+          MORE;
+        st->tok[st->len++] = *json++;
+        if (jsonw_character_n(NULL, st->tok + st->len, st->tok) ==
+            st->tok + st->len)
+          st->state = STREAM_STRING;
+      }
+      break;
+
+    case STREAM_TOKEN:
+      for (; json != end; json++) {
+        // a run of digits is as valid as its first two digits
+        if (st->len >= 2 && ISDIGIT(st->tok[st->len - 1]) &&
+            ISDIGIT(st->tok[st->len - 2]) && ISDIGIT(*json))
+          continue;
+        if (st->len == sizeof(st->tok))
+          FAIL;
+        st->tok[st->len] = *json;
+        if (!jsonw_viable(st->tok, st->len + 1))
+          break;
+        st->len++;
+      }
+      if (json == end && !eof)
+        return end;
+      if (st->len == 0 || jsonw_primitive_n(NULL, st->tok + st->len,
+                                            st->tok) != st->tok + st->len)
+        FAIL;
+      st->state = STREAM_AFTER;
+      break;
+
+    default:
+      FAIL;
+    }
+
+#undef MORE
+#undef FAIL
+#undef IN_OBJECT
+}
+
+#undef AT
+
+// NUL-terminated parsers are bounded parsers that never reach their bound
+
+char *jsonw_litchr(char chr, char *json) {
+  return jsonw_litchr_n(chr, NULL, json);
+}
+char *jsonw_litstr(char *str, char *json) {
+  return jsonw_litstr_n(str, NULL, json);
+}
+char *jsonw_ws(char *json) { return jsonw_ws_n(NULL, json); }
+char *jsonw_beginarr(char *json) { return jsonw_beginarr_n(NULL, json); }
+char *jsonw_endarr(char *json) { return jsonw_endarr_n(NULL, json); }
+char *jsonw_beginobj(char *json) { return jsonw_beginobj_n(NULL, json); }
+char *jsonw_endobj(char *json) { return jsonw_endobj_n(NULL, json); }
+char *jsonw_namesep(char *json) { return jsonw_namesep_n(NULL, json); }
+char *jsonw_valuesep(char *json) { return jsonw_valuesep_n(NULL, json); }
+char *jsonw_beginstr(char *json) { return jsonw_beginstr_n(NULL, json); }
+char *jsonw_endstr(char *json) { return jsonw_endstr_n(NULL, json); }
+char *jsonw_null(char *json) { return jsonw_null_n(NULL, json); }
+char *jsonw_boolean(bool *b, char *json) {
+  return jsonw_boolean_n(b, NULL, json);
+}
+char *jsonw_number(double *num, char *json) {
+  return jsonw_number_n(num, NULL, json);
+}
+char *jsonw_int64(int64_t *num, char *json) {
+  return jsonw_int64_n(num, NULL, json);
+}
+char *jsonw_uint64(uint64_t *num, char *json) {
+  return jsonw_uint64_n(num, NULL, json);
+}
+char *jsonw_character(char *chr, char *json) {
+  return jsonw_character_n(chr, NULL, json);
+}
+char *jsonw_utf8chr(char buf[4], size_t *len, char *json) {
+  return jsonw_utf8chr_n(buf, len, NULL, json);
+}
+char *jsonw_utf8(char *json) { return jsonw_utf8_n(NULL, json); }
+char *jsonw_string(size_t *len, char *json) {
+  return jsonw_string_n(len, NULL, json);
+}
+char *jsonw_rawstr(size_t *len, bool *esc, char *json) {
+  return jsonw_rawstr_n(len, esc, NULL, json);
+}
+char *jsonw_name(char *json) { return jsonw_name_n(NULL, json); }
+char *jsonw_element(char *json) { return jsonw_element_n(NULL, json); }
+char *jsonw_member(char *json) { return jsonw_member_n(NULL, json); }
+char *jsonw_array(size_t *len, char *json) {
+  return jsonw_array_n(len, NULL, json);
+}
+char *jsonw_object(size_t *len, char *json) {
+  return jsonw_object_n(len, NULL, json);
+}
+char *jsonw_primitive(jsonw_ty *type, char *json) {
+  return jsonw_primitive_n(type, NULL, json);
+}
+char *jsonw_structured(jsonw_ty *type, char *json) {
+  return jsonw_structured_n(type, NULL, json);
+}
+char *jsonw_value(jsonw_ty *type, char *json) {
+  return jsonw_value_n(type, NULL, json);
+}
+char *jsonw_text(jsonw_ty *type, char *json) {
+  return jsonw_text_n(type, NULL, json);
+}
+int jsonw_strcmp(char *str, char *json) {
+  return jsonw_strcmp_n(str, NULL, json);
+}
+char *jsonw_index(size_t idx, char *json) {
+  return jsonw_index_n(idx, NULL, json);
+}
+char *jsonw_begincur(jsonw_cursor *cur, char *json) {
+  return jsonw_begincur_n(cur, NULL, json);
+}
+char *jsonw_find(char *name, char *json) {
+  return jsonw_find_n(name, NULL, json);
+}
+char *jsonw_lookup(char *name, char *json) {
+  return jsonw_lookup_n(name, NULL, json);
+}
+char *jsonw_lookups(char **vals, jsonw_keys *keys, bool last, char *json) {
+  return jsonw_lookups_n(vals, keys, last, NULL, json);
+}
+char *jsonw_shaped(char **vals, jsonw_shape *shape, bool last, char *json) {
+  return jsonw_shaped_n(vals, shape, last, NULL, json);
+}
+char *jsonw_document(char *json) { return jsonw_document_n(NULL, json); }
+char *jsonw_query(char **vals, char **progs, size_t n, char *json) {
+  return jsonw_query_n(vals, progs, n, NULL, json);
+}
+char *jsonw_queryall(jsonw_match *match, void *ctx, char **progs, size_t n,
+                     char *json) {
+  return jsonw_queryall_n(match, ctx, progs, n, NULL, json);
+}
+char *jsonw_numbers(double *out, size_t cap, size_t *count, char *json) {
+  return jsonw_numbers_n(out, cap, count, NULL, json);
+}
+char *jsonw_int64s(int64_t *out, size_t cap, size_t *count, char *json) {
+  return jsonw_int64s_n(out, cap, count, NULL, json);
+}
+size_t jsonw_project(jsonw_column *cols, jsonw_shape *shape, size_t cap,
+                     char *json) {
+  return jsonw_project_n(cols, shape, cap, NULL, json);
+}
+size_t jsonw_projectarr(jsonw_column *cols, jsonw_shape *shape, size_t cap,
+                        char *json) {
+  return jsonw_projectarr_n(cols, shape, cap, NULL, json);
+}
+size_t jsonw_split(char **elems, size_t n, char *json) {
+  return jsonw_split_n(elems, n, NULL, json);
+}
+char *jsonw_unescape(char *buf, size_t size, char *json) {
+  return jsonw_unescape_n(buf, size, NULL, json);
+}
+char *jsonw_decode(char *buf, size_t size, char *json) {
+  return jsonw_decode_n(buf, size, NULL, json);
+}
+char *jsonw_unquote(size_t *len, char *json) {
+  return jsonw_unquote_n(len, NULL, json);
+}
+char *jsonw_minify(char *json) {
+  if (json && (json = jsonw_minify_n(json + strlen(json), json)))
+    *json = '\0';
+  return json;
+}
+
+// jsonw.h includes this file in header-only builds, so leave no macros behind
+#undef OUT_PARAM
+#undef JSON_ESCAPES
+#undef JSON_CODEPTS
+#undef STAT_CALL
+#undef STAT_OK
+#undef STAT_MISS
+#undef STAT_DEPTH
+#undef STR_STOP
+#undef ISDIGIT
@@ -1,5 +1,48 @@
+#ifndef JSONW_H
+#define JSONW_H
+
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+// structured types nested deeper than this fail to parse
+#ifndef JSONW_MAX_DEPTH
+#define JSONW_MAX_DEPTH 1024
+#endif
+
+// key sets hashed by `jsonw_hashkeys` hold at most this many keys
+#ifndef JSONW_MAX_KEYS
+#define JSONW_MAX_KEYS 64
+#endif
+
+// shapes learned by `jsonw_shaped` hold at most this many members
+#ifndef JSONW_MAX_MEMBERS
+#define JSONW_MAX_MEMBERS 64
+#endif
+
+// path queries evaluate at most this many paths at once
+#ifndef JSONW_MAX_PATHS
+#define JSONW_MAX_PATHS 64
+#endif
+
+// define `JSONW_VALIDATE_UTF8` for string literals that aren't valid UTF-8, as
+// checked by `jsonw_utf8`, to fail to parse, including with `jsonw_feed`
+
+// define `JSONW_TRUSTED` for texts to be assumed valid, so that `jsonw_value`
+// and the parsers built on it, such as `jsonw_element` and `jsonw_lookup`, only
+// find the ends of values like the unchecked parsers. `jsonw_text` still checks
+// the grammar
+
+// define `JSONW_INLINE` before including jsonw.h for a header-only build: every
+// function is then defined `static inline` in the including file, so that calls
+// can be inlined and specialized to their arguments without link-time
+// optimization. NUL-terminated parsers are bounded parsers with a `NULL` `end`,
+// so inlined calls to either kind only check for what they need to
+#ifdef JSONW_INLINE
+#define JSONW_API static inline
+#else
+#define JSONW_API
+#endif
 
 typedef enum {
   JSONW_NULL,
@@ -10,42 +53,423 @@ typedef enum {
   JSONW_OBJECT,
 } jsonw_ty;
 
+// structural index of a text: a mark for every bracket outside of string
+// literals, in text order
+typedef struct {
+  uint32_t off;  // offset of the bracket from the start of the text
+  uint32_t link; // opening: index of the closing mark; closing: element count
+} jsonw_mark;
+
+typedef struct {
+  char *json, *end;  // the indexed text
+  jsonw_mark *marks; // caller-allocated
+  size_t len;        // number of marks
+  size_t hint;       // most recently used mark
+} jsonw_sidx;
+
+// tape of a text: an entry per value, in text order, so that the entries of
+// the elements or members of an array or object directly follow its own
+typedef struct {
+  jsonw_ty type;
+  uint32_t off;   // offset of the value from the start of the text
+  uint32_t size;  // number of entries of the value and everything it holds
+  uint32_t len;   // number of elements or members of an array or object
+  uint32_t table; // first slot of the key table of an object, or `UINT32_MAX`
+} jsonw_entry;
+
+// member of an object in its key table, ordered by name, then in text order
+typedef struct {
+  uint32_t name; // offset of the name from the start of the text
+  uint32_t ent;  // entry of the value
+} jsonw_slot;
+
+// state of a tape built by `jsonw_build`. zero-initialize it but for `ents`,
+// `cap`, `slots` and `slotcap`. a slot per member of the text is enough
+typedef struct {
+  char *json, *end;        // the taped text
+  jsonw_entry *ents;       // caller-allocated
+  size_t cap, len;         // size of `ents`, and number of entries
+  jsonw_slot *slots;       // caller-allocated, or `NULL` for no key tables
+  size_t slotcap, slotlen; // size of `slots`, and number of slots
+  size_t hint;             // most recently used entry
+} jsonw_tape;
+
+// position in an array, so that subscripting it in increasing order with
+// `jsonw_at` takes time linear in the size of the array
+typedef struct {
+  char *end;          // end of the text, or `NULL` if NUL-terminated
+  char *first, *elem; // first element, and element `idx`
+  size_t idx;         // most recently reached subscript
+  size_t len;         // number of elements once known, or else `SIZE_MAX`
+  char *close;        // one past the array once `len` is known
+} jsonw_cursor;
+
+// set of key names for `jsonw_lookups`, hashed on length, first and last byte
+typedef struct {
+  char **names;                       // distinct key names
+  size_t len;                         // number of names
+  size_t lens[JSONW_MAX_KEYS];        // `strlen` of each name
+  uint16_t slots[2 * JSONW_MAX_KEYS]; // open addressing; 1 + index of a name
+} jsonw_keys;
+
+// sequence of member names of the last object that `jsonw_shaped` looked up
+// `keys` in, as raw bytes. zero-initialize it but for `keys`
+typedef struct {
+  jsonw_keys *keys;
+  size_t len;                           // number of members
+  uint16_t idx[JSONW_MAX_MEMBERS];      // index of each name in `keys`
+  uint16_t offs[JSONW_MAX_MEMBERS + 1]; // offset of each name in `raw`
+  char raw[16 * JSONW_MAX_MEMBERS];     // names, without quotes
+} jsonw_shape;
+
+// type of the values of a column of a projection
+typedef enum {
+  JSONW_COL_DOUBLE, // numbers, as with `jsonw_number`
+  JSONW_COL_INT64,  // integers, as with `jsonw_int64`
+  JSONW_COL_SPAN,   // string literals, as with `jsonw_rawstr`
+} jsonw_colty;
+
+// string literal as the `len` raw bytes at `str`, and whether any are escapes
+typedef struct {
+  char *str;
+  size_t len;
+  bool esc;
+} jsonw_span;
+
+// column of a projection, holding the value of a key for every record
+typedef struct {
+  jsonw_colty type;
+  void *vals;           // `double`, `int64_t` or `jsonw_span` per record
+  unsigned char *valid; // bit per record, least significant first, or `NULL`
+} jsonw_column;
+
+// called by `jsonw_queryall` for the value `json` matched by path `path`
+typedef void jsonw_match(void *ctx, size_t path, char *json);
+
+// state of a text parsed in chunks by `jsonw_feed`. zero-initialize it before
+// feeding the first chunk
+typedef struct {
+  unsigned char stack[(JSONW_MAX_DEPTH + 7) / 8]; // bit per level, for objects
+  size_t depth;                                   // number of open brackets
+  int state;                                      // position in the grammar
+  bool name;                                      // whether in a name
+  size_t len;                                     // length of `tok`
+  char tok[16];                                   // partial token
+  unsigned char utf8[3];                          // partial UTF-8 sequence
+} jsonw_stream;
+
+// called with the `len` bytes of `buf` as a writer fills it up. returns
+// `false` on failure
+typedef bool jsonw_write(void *ctx, char *buf, size_t len);
+
+// state of a text written by the writers. zero-initialize it but for `buf`,
+// `size`, `write` and `ctx`
+typedef struct {
+  char *buf;          // caller-allocated
+  size_t size, len;   // size of `buf`, and number of bytes written to it
+  jsonw_write *write; // called when `buf` is full, or `NULL` to fail instead
+  void *ctx;          // passed to `write`
+  bool sep;           // whether a value separator is due before a value
+} jsonw_writer;
+
 // basic parsers
-char *jsonw_litchr(char chr, char *json);  // literal character `chr`
-char *jsonw_litstr(char *str, char *json); // literal string `str`
+JSONW_API char *jsonw_litchr(char chr, char *json);  // literal character `chr`
+JSONW_API char *jsonw_litstr(char *str, char *json); // literal string `str`
 
 // characters
-char *jsonw_ws(char *json);       // /[ \t\n\r]*/
-char *jsonw_beginarr(char *json); // ws '[' ws
-char *jsonw_endarr(char *json);   // ws ']' ws
-char *jsonw_beginobj(char *json); // ws '{' ws
-char *jsonw_endobj(char *json);   // ws '}' ws
-char *jsonw_namesep(char *json);  // ws ':' ws
-char *jsonw_valuesep(char *json); // ws ',' ws
-char *jsonw_beginstr(char *json); // '"'
-char *jsonw_endstr(char *json);   // '"'
+JSONW_API char *jsonw_ws(char *json);       // /[ \t\n\r]*/
+JSONW_API char *jsonw_beginarr(char *json); // ws '[' ws
+JSONW_API char *jsonw_endarr(char *json);   // ws ']' ws
+JSONW_API char *jsonw_beginobj(char *json); // ws '{' ws
+JSONW_API char *jsonw_endobj(char *json);   // ws '}' ws
+JSONW_API char *jsonw_namesep(char *json);  // ws ':' ws
+JSONW_API char *jsonw_valuesep(char *json); // ws ',' ws
+JSONW_API char *jsonw_beginstr(char *json); // '"'
+JSONW_API char *jsonw_endstr(char *json);   // '"'
+JSONW_API char *jsonw_utf8(char *json); // valid UTF-8 up to the terminating NUL
 
 // values, texts
-char *jsonw_null(char *json);                       // 'null'
-char *jsonw_boolean(bool *b, char *json);           // 'true' | 'false'
-char *jsonw_number(double *num, char *json);        // e.g. '64', '-1.5e+10'
-char *jsonw_character(char *chr, char *json);       // e.g. 'c', '\n', '\u007c'
-char *jsonw_string(size_t *len, char *json);        // e.g. '"abc"', '"\tdef\n"'
-char *jsonw_name(char *json);                       // e.g. '"abc":'
-char *jsonw_element(char *json);                    // e.g. '"def",', '123,'
-char *jsonw_member(char *json);                     // e.g. '"abc": 123,'
-char *jsonw_array(size_t *len, char *json);         // e.g. '[ "def", 123 }'
-char *jsonw_object(size_t *len, char *json);        // e.g. '{ "abc": 123 }'
-char *jsonw_primitive(jsonw_ty *type, char *json);  // null | bool | num | str
-char *jsonw_structured(jsonw_ty *type, char *json); // object | array
-char *jsonw_value(jsonw_ty *type, char *json);      // primitive | structured
-char *jsonw_text(jsonw_ty *type, char *json);       // ws value ws
+JSONW_API char *jsonw_null(char *json);                // 'null'
+JSONW_API char *jsonw_boolean(bool *b, char *json);    // 'true' | 'false'
+JSONW_API char *jsonw_number(double *num, char *json); // e.g. '64', '-1.5e+10'
+JSONW_API char *jsonw_int64(int64_t *num, char *json); // e.g. '64', '-42'
+JSONW_API char *jsonw_uint64(uint64_t *num, char *json); // e.g. '64', '0'
+// e.g. 'c', '\n', '\u007c'
+JSONW_API char *jsonw_character(char *chr, char *json);
+// character as the `len` bytes of its UTF-8 encoding, e.g. '\u00e9' and
+// '\ud834\udd1e'. unescaped bytes are copied as is
+JSONW_API char *jsonw_utf8chr(char buf[4], size_t *len, char *json);
+// e.g. '"abc"', '"\tdef\n"'
+JSONW_API char *jsonw_string(size_t *len, char *json);
+JSONW_API char *jsonw_name(char *json);                // e.g. '"abc":'
+JSONW_API char *jsonw_element(char *json);             // e.g. '"def",', '123,'
+JSONW_API char *jsonw_member(char *json);              // e.g. '"abc": 123,'
+JSONW_API char *jsonw_array(size_t *len, char *json);  // e.g. '[ "def", 123 }'
+JSONW_API char *jsonw_object(size_t *len, char *json); // e.g. '{ "abc": 123 }'
+// null | bool | num | str
+JSONW_API char *jsonw_primitive(jsonw_ty *type, char *json);
+JSONW_API char *jsonw_structured(jsonw_ty *type, char *json); // object | array
+// primitive | structured
+JSONW_API char *jsonw_value(jsonw_ty *type, char *json);
+JSONW_API char *jsonw_text(jsonw_ty *type, char *json); // ws value ws
+// string literal as the `len` raw bytes following its opening quote, and
+// whether any of them are escapes, in which case they need `jsonw_unescape`
+JSONW_API char *jsonw_rawstr(size_t *len, bool *esc, char *json);
 
 // utilities
-int jsonw_strcmp(char *str, char *json); // compare C string to JSON string lit
-char *jsonw_index(size_t idx, char *json);  // get subscript `idx` of array
-char *jsonw_find(char *name, char *json);   // find key `name` in object
-char *jsonw_lookup(char *name, char *json); // look up value of key `name`
-char *jsonw_quote(char buf[sizeof("\\u0000")], char chr); // escape char lit
-char *jsonw_escape(char *buf, size_t size, char *str);    // escape string lit
-char *jsonw_unescape(char *buf, size_t size, char *json); // unecsape string lit
+// compare C string to JSON string lit
+JSONW_API int jsonw_strcmp(char *str, char *json);
+// get subscript `idx` of array
+JSONW_API char *jsonw_index(size_t idx, char *json);
+// same, resuming from the subscript most recently reached through `cur`, and
+// one past the array, whose number of elements is then known
+JSONW_API char *jsonw_begincur(jsonw_cursor *cur, char *json); // ws '[' ws
+JSONW_API char *jsonw_at(size_t idx, jsonw_cursor *cur);
+JSONW_API char *jsonw_endcur(size_t *len, jsonw_cursor *cur);
+JSONW_API char *jsonw_find(char *name, char *json); // find key `name` in object
+// look up value of key `name`
+JSONW_API char *jsonw_lookup(char *name, char *json);
+// look up values of all keys in `keys` at once, of their first or `last` match
+JSONW_API bool jsonw_hashkeys(jsonw_keys *keys, char **names, size_t len);
+JSONW_API char *jsonw_lookups(char **vals, jsonw_keys *keys, bool last,
+                              char *json);
+// same, checking member names against those of the previous object first, so
+// that objects with the same names in the same order take `memcmp`s only
+JSONW_API char *jsonw_shaped(char **vals, jsonw_shape *shape, bool last,
+                             char *json);
+// next of concatenated texts, e.g. NDJSON, or the end of the last one. `NULL`
+// if the text at `json` is invalid, so invalid last texts are reported too
+JSONW_API char *jsonw_document(char *json);
+// project the values of the keys of `shape` in the first `cap` records into
+// `cols`, a column per key. a value's bit in `valid` is set if the record is an
+// object with the key and the value is of the column's type. records are the
+// lines of an NDJSON log, but for lines of only whitespace, or the elements of
+// an array. returns the number of records
+JSONW_API size_t jsonw_project(jsonw_column *cols, jsonw_shape *shape,
+                               size_t cap, char *json);
+JSONW_API size_t jsonw_projectarr(jsonw_column *cols, jsonw_shape *shape,
+                                  size_t cap, char *json);
+// split array into up to `n` runs of elements of about the same size in bytes,
+// setting `elems` to the first element of each run. returns the number of runs
+JSONW_API size_t jsonw_split(char **elems, size_t n, char *json);
+// compile the path `path` into the program `prog`, of `size` bytes. paths are
+// keys, array subscripts and wildcards, e.g. 'size.width', 'items[3].id',
+// 'items[*].price', '[0].*', with '\\' escaping the next character of a key.
+// returns one past the program, where another program can be compiled
+JSONW_API char *jsonw_compile(char *prog, size_t size, char *path);
+// look up the values matched by each of the `n` programs at `progs` in a single
+// pass over the value `json`, setting `vals` to their first match, or calling
+// `match` for every match, in text order
+JSONW_API char *jsonw_query(char **vals, char **progs, size_t n, char *json);
+JSONW_API char *jsonw_queryall(jsonw_match *match, void *ctx, char **progs,
+                               size_t n, char *json);
+// elements of an array of only numbers, parsed into the first `cap` entries of
+// `out`, and their `count`. fails if there are more, writing to `out` anyway
+JSONW_API char *jsonw_numbers(double *out, size_t cap, size_t *count,
+                              char *json);
+JSONW_API char *jsonw_int64s(int64_t *out, size_t cap, size_t *count,
+                             char *json);
+// escape char lit
+JSONW_API char *jsonw_quote(char buf[sizeof("\\u0000")], char chr);
+// escape string lit
+JSONW_API char *jsonw_escape(char *buf, size_t size, char *str);
+// unescape string lit
+JSONW_API char *jsonw_unescape(char *buf, size_t size, char *json);
+// same, to UTF-8
+JSONW_API char *jsonw_decode(char *buf, size_t size, char *json);
+// unescape string literal into its own bytes, from its opening quote on, and
+// NUL-terminate it. the literal is left garbled on parse failure
+JSONW_API char *jsonw_unquote(size_t *len, char *json);
+// strip whitespace outside string literals in place, returning the new end of
+// the text. the grammar isn't checked, and concatenated texts may run together
+JSONW_API char *jsonw_minify(char *json);
+
+// writers: append to the text of `w`, with separators between values, and
+// return `w`, or `NULL` on failure. like parsers, they short-circuit out when
+// they receive `NULL` as input
+JSONW_API jsonw_writer *jsonw_putbeginarr(jsonw_writer *w); // '['
+JSONW_API jsonw_writer *jsonw_putendarr(jsonw_writer *w);   // ']'
+JSONW_API jsonw_writer *jsonw_putbeginobj(jsonw_writer *w); // '{'
+JSONW_API jsonw_writer *jsonw_putendobj(jsonw_writer *w);   // '}'
+// e.g. '"abc":'
+JSONW_API jsonw_writer *jsonw_putname(char *name, jsonw_writer *w);
+JSONW_API jsonw_writer *jsonw_putnull(jsonw_writer *w);            // 'null'
+JSONW_API jsonw_writer *jsonw_putboolean(bool b, jsonw_writer *w); // 'true'
+// e.g. '-1.5e-7'
+JSONW_API jsonw_writer *jsonw_putnumber(double num, jsonw_writer *w);
+// e.g. '-42'
+JSONW_API jsonw_writer *jsonw_putint64(int64_t num, jsonw_writer *w);
+// e.g. '64'
+JSONW_API jsonw_writer *jsonw_putuint64(uint64_t num, jsonw_writer *w);
+// e.g. '"\tdef\n"'
+JSONW_API jsonw_writer *jsonw_putstring(char *str, jsonw_writer *w);
+// hand the rest of `buf` to `write`
+JSONW_API jsonw_writer *jsonw_flush(jsonw_writer *w);
+// a number that reads back as `num`, almost always the shortest one, NUL-
+// terminated. returns a pointer to the NUL, or `NULL` for infinities and NaNs
+JSONW_API char *jsonw_dtoa(char buf[sizeof("-0.0000012345678901234567")],
+                           double num);
+
+// bounded parsers: same as above but never read at or past `end`, so texts
+// need not be NUL-terminated. reaching `end` is like reaching a NUL
+JSONW_API char *jsonw_litchr_n(char chr, char *end, char *json);
+JSONW_API char *jsonw_litstr_n(char *str, char *end, char *json);
+JSONW_API char *jsonw_ws_n(char *end, char *json);
+JSONW_API char *jsonw_utf8_n(char *end, char *json);
+JSONW_API char *jsonw_beginarr_n(char *end, char *json);
+JSONW_API char *jsonw_endarr_n(char *end, char *json);
+JSONW_API char *jsonw_beginobj_n(char *end, char *json);
+JSONW_API char *jsonw_endobj_n(char *end, char *json);
+JSONW_API char *jsonw_namesep_n(char *end, char *json);
+JSONW_API char *jsonw_valuesep_n(char *end, char *json);
+JSONW_API char *jsonw_beginstr_n(char *end, char *json);
+JSONW_API char *jsonw_endstr_n(char *end, char *json);
+JSONW_API char *jsonw_null_n(char *end, char *json);
+JSONW_API char *jsonw_boolean_n(bool *b, char *end, char *json);
+JSONW_API char *jsonw_number_n(double *num, char *end, char *json);
+JSONW_API char *jsonw_int64_n(int64_t *num, char *end, char *json);
+JSONW_API char *jsonw_uint64_n(uint64_t *num, char *end, char *json);
+JSONW_API char *jsonw_character_n(char *chr, char *end, char *json);
+JSONW_API char *jsonw_utf8chr_n(char buf[4], size_t *len, char *end,
+                                char *json);
+JSONW_API char *jsonw_string_n(size_t *len, char *end, char *json);
+JSONW_API char *jsonw_rawstr_n(size_t *len, bool *esc, char *end, char *json);
+JSONW_API char *jsonw_name_n(char *end, char *json);
+JSONW_API char *jsonw_element_n(char *end, char *json);
+JSONW_API char *jsonw_member_n(char *end, char *json);
+JSONW_API char *jsonw_array_n(size_t *len, char *end, char *json);
+JSONW_API char *jsonw_object_n(size_t *len, char *end, char *json);
+JSONW_API char *jsonw_primitive_n(jsonw_ty *type, char *end, char *json);
+JSONW_API char *jsonw_structured_n(jsonw_ty *type, char *end, char *json);
+JSONW_API char *jsonw_value_n(jsonw_ty *type, char *end, char *json);
+JSONW_API char *jsonw_text_n(jsonw_ty *type, char *end, char *json);
+JSONW_API int jsonw_strcmp_n(char *str, char *end, char *json);
+JSONW_API char *jsonw_index_n(size_t idx, char *end, char *json);
+JSONW_API char *jsonw_begincur_n(jsonw_cursor *cur, char *end, char *json);
+JSONW_API char *jsonw_find_n(char *name, char *end, char *json);
+JSONW_API char *jsonw_lookup_n(char *name, char *end, char *json);
+JSONW_API char *jsonw_lookups_n(char **vals, jsonw_keys *keys, bool last,
+                                char *end, char *json);
+JSONW_API char *jsonw_shaped_n(char **vals, jsonw_shape *shape, bool last,
+                               char *end, char *json);
+JSONW_API char *jsonw_document_n(char *end, char *json);
+JSONW_API size_t jsonw_split_n(char **elems, size_t n, char *end, char *json);
+JSONW_API char *jsonw_query_n(char **vals, char **progs, size_t n, char *end,
+                              char *json);
+JSONW_API char *jsonw_queryall_n(jsonw_match *match, void *ctx, char **progs,
+                                 size_t n, char *end, char *json);
+JSONW_API char *jsonw_numbers_n(double *out, size_t cap, size_t *count,
+                                char *end, char *json);
+JSONW_API char *jsonw_int64s_n(int64_t *out, size_t cap, size_t *count,
+                               char *end, char *json);
+JSONW_API size_t jsonw_project_n(jsonw_column *cols, jsonw_shape *shape,
+                                 size_t cap, char *end, char *json);
+JSONW_API size_t jsonw_projectarr_n(jsonw_column *cols, jsonw_shape *shape,
+                                    size_t cap, char *end, char *json);
+JSONW_API char *jsonw_unescape_n(char *buf, size_t size, char *end, char *json);
+JSONW_API char *jsonw_decode_n(char *buf, size_t size, char *end, char *json);
+JSONW_API char *jsonw_unquote_n(size_t *len, char *end, char *json);
+JSONW_API char *jsonw_minify_n(char *end, char *json);
+
+// indexed parsers: same as above but jump over structured types in constant
+// time using an index built by `jsonw_structure`. texts are assumed valid;
+// the insides of the structured types jumped over are never looked at
+// index `cap` brackets at most
+JSONW_API bool jsonw_structure(jsonw_sidx *sidx, jsonw_mark *marks, size_t cap,
+                               char *end, char *json);
+JSONW_API char *jsonw_element_i(jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_member_i(jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_array_i(size_t *len, jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_object_i(size_t *len, jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_value_i(jsonw_ty *type, jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_index_i(size_t idx, jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_find_i(char *name, jsonw_sidx *sidx, char *json);
+JSONW_API char *jsonw_lookup_i(char *name, jsonw_sidx *sidx, char *json);
+// runs only start at structured elements, but finding them takes time linear
+// in the number of structured elements rather than in the size of the array
+JSONW_API size_t jsonw_split_i(char **elems, size_t n, jsonw_sidx *sidx,
+                               char *json);
+
+// tape parsers: find values through a tape built by `jsonw_build` in a single
+// pass, looking at the text again only to compare names. texts are assumed
+// unchanged since. unlike `jsonw_index` and `jsonw_lookup`, they take arrays
+// and objects themselves. subscripting hops over entries, and objects with a
+// key table are looked up by binary search
+JSONW_API char *jsonw_build(jsonw_tape *tape, char *end, char *json); // text
+// entry of the value `json` refers to, or `NULL` if it isn't on the tape
+JSONW_API jsonw_entry *jsonw_entryat(jsonw_tape *tape, char *json);
+JSONW_API char *jsonw_index_t(size_t idx, jsonw_tape *tape, char *json);
+JSONW_API char *jsonw_lookup_t(char *name, jsonw_tape *tape, char *json);
+
+// unchecked parsers: same as the bounded parsers but only find the ends of
+// values, by counting brackets and finding unescaped quotes, without checking
+// the grammar. texts are assumed valid, e.g. as checked by `jsonw_text`
+JSONW_API char *jsonw_value_u(jsonw_ty *type, char *end, char *json);
+JSONW_API char *jsonw_element_u(char *end, char *json);
+JSONW_API char *jsonw_member_u(char *end, char *json);
+JSONW_API char *jsonw_index_u(size_t idx, char *end, char *json);
+JSONW_API char *jsonw_find_u(char *name, char *end, char *json);
+JSONW_API char *jsonw_lookup_u(char *name, char *end, char *json);
+
+// streaming parser: parses the chunk from `json` to `end` of a text arriving in
+// chunks, like `jsonw_text` would the whole text. returns `end` if the text may
+// continue into the next chunk, a pointer one past the end of the text if it
+// ends before `end`, or `NULL` on parse failure. an empty chunk, where `json`
+// is `end`, marks the end of input
+JSONW_API char *jsonw_feed(jsonw_stream *st, char *end, char *json);
+
+// instrumentation: define `JSONW_STATS` for parsers to count their calls into
+// counters of the calling thread. without it, none of this exists and parsers
+// cost nothing extra
+#ifdef JSONW_STATS
+
+// parsers with counters, indexing `jsonw_stats.parsers`. the NUL-terminated
+// and bounded parsers share theirs; indexed and unchecked parsers have none
+typedef enum {
+  JSONW_STAT_NULL,
+  JSONW_STAT_BOOLEAN,
+  JSONW_STAT_NUMBER,
+  JSONW_STAT_INT64,
+  JSONW_STAT_UINT64,
+  JSONW_STAT_STRING,
+  JSONW_STAT_RAWSTR,
+  JSONW_STAT_ARRAY,
+  JSONW_STAT_OBJECT,
+  JSONW_STAT_PRIMITIVE,
+  JSONW_STAT_STRUCTURED,
+  JSONW_STAT_VALUE,
+  JSONW_STAT_TEXT,
+  JSONW_STAT_FIND,
+  JSONW_STAT_LOOKUPS,
+  JSONW_STAT_SHAPED,
+  JSONW_STAT_LEN,
+} jsonw_stat;
+
+typedef struct {
+  uint64_t calls; // calls that received something other than `NULL`
+  uint64_t fails; // calls that failed
+  uint64_t bytes; // bytes consumed by calls that succeeded
+} jsonw_counter;
+
+typedef struct {
+  jsonw_counter parsers[JSONW_STAT_LEN];
+  // parsers that `jsonw_primitive` and `jsonw_structured` dispatched to on the
+  // first character but that failed, e.g. from `jsonw_value` on arbitrary input
+  uint64_t misses;
+  size_t depth; // deepest nesting of `jsonw_array`, `jsonw_object` and the like
+} jsonw_stats;
+
+JSONW_API jsonw_stats *jsonw_getstats(void); // counters of the calling thread
+// zero the counters of the calling thread
+JSONW_API void jsonw_resetstats(void);
+// print the counters of the calling thread into the `size` bytes of `buf` as
+// lines of tab-separated columns, like `snprintf`
+JSONW_API int jsonw_dumpstats(char *buf, size_t size);
+
+#endif
+
+#ifdef JSONW_INLINE
+#include "jsonw.c"
+#endif
+
+#endif
@@ -0,0 +1,430 @@
+#define _POSIX_C_SOURCE 200112L
+#include "jsonw.h"
+#include "jsonw_par.h"
+#include <pthread.h>
+#include <string.h>
+
+// chunks are at least this big, so that claiming one costs next to nothing
+#define MIN_CHUNK (64 * 1024)
+
+typedef struct {
+  char *next, *end; // unclaimed part of the log
+  size_t chunk;     // nominal chunk size
+  size_t claimed, emitted, records, invalid;
+  jsonw_visit *visit;
+  jsonw_emit *emit;
+  void *ctx;
+  pthread_mutex_t lock;
+  pthread_cond_t turn; // signaled when a chunk is emitted
+} jsonw_job;
+
+static void *jsonw_worker(void *arg) {
+  jsonw_job *job = arg;
+  while (1) {
+    jsonw_chunk chunk = {NULL};
+    pthread_mutex_lock(&job->lock);
+    if (job->next == job->end)
+      return pthread_mutex_unlock(&job->lock), NULL;
+    // valid texts have no raw newlines in their string literals, so any
+    // newline ends a record
+    char *split = job->end - job->next > job->chunk ? job->next + job->chunk
+                                                     : job->end;
+    char *eol = memchr(split, '\n', job->end - split);
+    chunk.json = job->next, chunk.end = job->next = eol ? eol + 1 : job->end;
+    size_t idx = job->claimed++;
+    pthread_mutex_unlock(&job->lock);
+
+    for (char *rec = chunk.json; rec != chunk.end; rec = eol + 1) {
+      if ((eol = memchr(rec, '\n', chunk.end - rec)) == NULL)
+        eol = chunk.end - 1; // last record of a log without a final newline
+      char *end = eol + (*eol != '\n');
+      if (jsonw_ws_n(end, rec) == end)
+        continue;
+      bool valid = jsonw_text_n(NULL, end, rec) == end;
+      if (job->visit)
+        job->visit(job->ctx, &chunk, valid, end, rec);
+      chunk.len++, chunk.invalid += !valid;
+    }
+
+    // wait for the chunks before this one to be emitted
+    pthread_mutex_lock(&job->lock);
+    while (job->emitted != idx)
+      pthread_cond_wait(&job->turn, &job->lock);
+    chunk.first = job->records;
+    job->records += chunk.len, job->invalid += chunk.invalid;
+    pthread_mutex_unlock(&job->lock);
+
+    if (job->emit)
+      job->emit(job->ctx, &chunk);
+    pthread_mutex_lock(&job->lock);
+    job->emitted++;
+    pthread_cond_broadcast(&job->turn);
+    pthread_mutex_unlock(&job->lock);
+  }
+}
+
+size_t jsonw_ndjson(jsonw_visit *visit, jsonw_emit *emit, void *ctx,
+                    int threads, char *end, char *json) {
+  if (threads > JSONW_MAX_THREADS)
+    threads = JSONW_MAX_THREADS;
+  if (threads < 1)
+    threads = 1;
+
+  // a few chunks per thread even out records that take longer than others
+  size_t size = end - json, chunk = size / ((size_t)threads * 8);
+  jsonw_job job = {.next = json, .end = end, .visit = visit, .emit = emit,
+                   .ctx = ctx, .chunk = chunk < MIN_CHUNK ? MIN_CHUNK : chunk};
+  pthread_mutex_init(&job.lock, NULL);
+  pthread_cond_init(&job.turn, NULL);
+
+  // the calling thread is a worker too, so failing to start threads is fine
+  pthread_t tids[JSONW_MAX_THREADS];
+  int started = 0;
+  while (started < threads - 1 &&
+         pthread_create(tids + started, NULL, jsonw_worker, &job) == 0)
+    started++;
+  jsonw_worker(&job);
+  while (started--)
+    pthread_join(tids[started], NULL);
+
+  pthread_cond_destroy(&job.turn);
+  pthread_mutex_destroy(&job.lock);
+  return job.invalid;
+}
+
+// a range of whole lines of an NDJSON log, projected by a single thread
+typedef struct {
+  char *json, *end; // the lines
+  size_t first;     // index of the first record of the range
+  size_t len;       // number of records of the range
+  size_t lo, hi;    // rows projected by the thread, from and to `json`
+  char *from, *to;
+  jsonw_column *cols;
+  jsonw_keys *keys;
+  size_t cap;
+} jsonw_range;
+
+// a pointer past the first `n` records from `json`, like `jsonw_project_n`
+static char *jsonw_skiprecs(size_t n, char *end, char *json) {
+  while (json != end) {
+    char *eol = memchr(json, '\n', end - json);
+    eol = eol ? eol : end;
+    if (jsonw_ws_n(eol, json) != eol && n-- == 0)
+      return json;
+    json = eol + (eol != end);
+  }
+  return json;
+}
+
+static void *jsonw_count(void *arg) {
+  jsonw_range *range = arg;
+  range->len = jsonw_project_n(NULL, NULL, 0, range->end, range->json);
+  return NULL;
+}
+
+static void *jsonw_projrange(void *arg) {
+  jsonw_range *range = arg;
+  jsonw_column cols[JSONW_MAX_KEYS];
+  jsonw_shape shape = {.keys = range->keys};
+  size_t hi = range->hi < range->cap ? range->hi : range->cap;
+  if (range->lo >= hi)
+    return NULL;
+
+  // columns of the rows of the range, whose bits start on a byte boundary
+  for (size_t i = 0; i < range->keys->len; i++) {
+    jsonw_column *col = range->cols + i;
+    size_t size = col->type == JSONW_COL_DOUBLE  ? sizeof(double)
+                  : col->type == JSONW_COL_INT64 ? sizeof(int64_t)
+                                                 : sizeof(jsonw_span);
+    cols[i] = (jsonw_column){col->type, (char *)col->vals + range->lo * size,
+                             col->valid ? col->valid + range->lo / 8 : NULL};
+  }
+  jsonw_project_n(cols, &shape, hi - range->lo, range->to, range->from);
+  return NULL;
+}
+
+// runs `fn` on each of the `n` args of `size` bytes, on threads of their own
+// but for the first. args whose threads fail to start are run in order on the
+// calling thread
+static void jsonw_runall(void *(*fn)(void *), void *args, size_t size, int n) {
+  pthread_t tids[JSONW_MAX_THREADS];
+  bool started[JSONW_MAX_THREADS];
+  for (int i = 1; i < n; i++)
+    started[i] =
+        pthread_create(tids + i, NULL, fn, (char *)args + size * i) == 0;
+  fn(args);
+  for (int i = 1; i < n; i++)
+    if (started[i])
+      pthread_join(tids[i], NULL);
+    else
+      fn((char *)args + size * i);
+}
+
+size_t jsonw_project_par(jsonw_column *cols, jsonw_keys *keys, size_t cap,
+                         int threads, char *end, char *json) {
+  if (threads > JSONW_MAX_THREADS)
+    threads = JSONW_MAX_THREADS;
+  if (threads < 1)
+    threads = 1;
+
+  // split the log into ranges of about the same size on line boundaries, and
+  // count the records of each range to know which rows they go to
+  jsonw_range ranges[JSONW_MAX_THREADS];
+  size_t size = end - json, len = 0;
+  for (int i = 0; i < threads; i++) {
+    char *split = json + size / threads * i, *eol;
+    if (i)
+      split = (eol = memchr(split, '\n', end - split)) ? eol + 1 : end;
+    ranges[i] = (jsonw_range){.json = split, .cols = cols, .keys = keys,
+                              .cap = cap};
+    if (i)
+      ranges[i - 1].end = split;
+  }
+  ranges[threads - 1].end = end;
+  jsonw_runall(jsonw_count, ranges, sizeof(*ranges), threads);
+
+  // threads project rows starting on a byte boundary of `valid`, so that no
+  // two threads write to the same byte, continuing into the next range
+  for (int i = 0; i < threads; i++)
+    ranges[i].first = len, len += ranges[i].len;
+  for (int i = 0; i < threads; i++) {
+    jsonw_range *range = ranges + i, *next = range + 1;
+    range->lo = (range->first + 7) / 8 * 8;
+    range->from = jsonw_skiprecs(range->lo - range->first, end, range->json);
+    range->hi = i + 1 < threads ? (next->first + 7) / 8 * 8 : len;
+    range->to = i + 1 < threads
+                    ? jsonw_skiprecs(range->hi - next->first, end, next->json)
+                    : end;
+  }
+  jsonw_runall(jsonw_projrange, ranges, sizeof(*ranges), threads);
+  return len;
+}
+
+// states of a level of nesting of a text, named after what comes next. a
+// piece of a text that doesn't open a level can start it in any state, so the
+// piece maps each state the level can start in to the one it ends in
+enum {
+  ARR_FIRST, // value or `]`
+  ARR_VALUE, // value
+  ARR_SEP,   // `,` or `]`
+  OBJ_FIRST, // name or `}`
+  OBJ_NAME,  // name
+  OBJ_COLON, // `:`
+  OBJ_VALUE, // value
+  OBJ_SEP,   // `,` or `}`
+  TOP_VALUE, // value, at the top level
+  TOP_DONE,  // nothing, at the top level
+  STATES,
+  BAD = STATES, // no state, once the piece isn't part of any text
+};
+
+// the state after a value, after a string (as a value or as a name), after a
+// `,` and after a `:`, in each state
+static const unsigned char jsonw_values[] = {
+    ARR_SEP, ARR_SEP, BAD, BAD, BAD, BAD, OBJ_SEP, BAD, TOP_DONE, BAD, BAD};
+static const unsigned char jsonw_strings[] = {
+    ARR_SEP, ARR_SEP, BAD, OBJ_COLON, OBJ_COLON, BAD, OBJ_SEP, BAD, TOP_DONE,
+    BAD,     BAD};
+static const unsigned char jsonw_commas[] = {
+    BAD, BAD, ARR_VALUE, BAD, BAD, BAD, BAD, OBJ_NAME, BAD, BAD, BAD};
+static const unsigned char jsonw_colons[] = {
+    BAD, BAD, BAD, BAD, BAD, OBJ_VALUE, BAD, BAD, BAD, BAD, BAD};
+
+// a piece of a text, validated by a single thread
+typedef struct {
+  char *json, *end; // the piece, from a split to the next one
+  size_t idx;       // index of the piece within the text
+  bool quoted;      // whether the piece starts within a string, once known
+  struct jsonw_whole *whole;
+} jsonw_piece;
+
+// a text validated in pieces, with the levels of nesting the pieces before the
+// one whose turn it is leave open
+typedef struct jsonw_whole {
+  char *end;
+  char *to; // where the pieces so far end, past whitespace
+  bool ok;  // whether the pieces so far fit together
+  size_t turn, depth;
+  unsigned char levels[JSONW_MAX_DEPTH + 1]; // the top level, then containers
+  pthread_mutex_t lock;
+  pthread_cond_t cond; // signaled when a piece is fitted
+} jsonw_whole;
+
+// whether the piece leaves a string open, were it to start outside of one.
+// pieces never start right after a backslash, so that's all there is to it
+static void *jsonw_quotes(void *arg) {
+  jsonw_piece *piece = arg;
+  bool quoted = false;
+  for (char *json = piece->json; json < piece->end; json++)
+    if (*json == '\\')
+      json++;
+    else if (*json == '"')
+      quoted = !quoted;
+  piece->quoted = quoted;
+  return NULL;
+}
+
+// whether `c` can be part of a number or a literal name
+#define ISWORD(c) ((c) != '\0' && strchr(" \t\n\r[]{},:\"", (c)) == NULL)
+
+// takes the innermost level the piece is at through a token
+#define STEP(TABLE)                                                            \
+  do {                                                                         \
+    if (nopens)                                                                \
+      ok = (opens[nopens - 1] = TABLE[opens[nopens - 1]]) != BAD;              \
+    else                                                                       \
+      for (int s = 0; s < STATES; s++)                                         \
+        map[s] = TABLE[map[s]];                                                \
+  } while (0)
+
+static void *jsonw_piecewise(void *arg) {
+  jsonw_piece *piece = arg;
+  jsonw_whole *whole = piece->whole;
+  char *end = whole->end, *json = piece->json;
+
+  // skip the rest of a token the pieces before this one start. if that's a
+  // guess gone wrong, the pieces won't fit together
+  if (piece->quoted)
+    while (json != end) {
+      char c = *json++;
+      if (c == '"')
+        break;
+      if (c == '\\' && json != end)
+        json++;
+    }
+  else if (piece->idx && json != end && ISWORD(json[-1]))
+    while (json != end && ISWORD(*json))
+      json++;
+  char *from = json = jsonw_ws_n(end, json);
+
+  // the level the piece starts at, as a map from the state it starts in to
+  // the state it ends in, the levels below it the piece closes, as the sets of
+  // states they can be closed from, and the levels the piece leaves open
+  unsigned char map[STATES], opens[JSONW_MAX_DEPTH];
+  uint16_t closes[JSONW_MAX_DEPTH];
+  size_t nopens = 0, ncloses = 0;
+  ptrdiff_t peak = 0; // most containers open at once, from the start
+  for (int s = 0; s < STATES; s++)
+    map[s] = s;
+
+  bool ok = true;
+  jsonw_ty type;
+  while (ok && (json = jsonw_ws_n(end, json)) < piece->end) {
+    switch (*json) {
+    case '[':
+    case '{':
+      STEP(jsonw_values);
+      if (nopens == JSONW_MAX_DEPTH)
+        ok = false;
+      else
+        opens[nopens++] = *json++ == '[' ? ARR_FIRST : OBJ_FIRST;
+      if ((ptrdiff_t)nopens - (ptrdiff_t)ncloses > peak)
+        peak = (ptrdiff_t)nopens - (ptrdiff_t)ncloses;
+      break;
+    case ']':
+    case '}':;
+      uint16_t closing = *json++ == ']' ? 1 << ARR_FIRST | 1 << ARR_SEP
+                                        : 1 << OBJ_FIRST | 1 << OBJ_SEP;
+      if (nopens)
+        ok = closing >> opens[--nopens] & 1;
+      else if (ncloses == JSONW_MAX_DEPTH)
+        ok = false;
+      else {
+        closes[ncloses] = 0;
+        for (int s = 0; s < STATES; s++) {
+          closes[ncloses] |= (map[s] != BAD && closing >> map[s] & 1) << s;
+          map[s] = s; // the level took the container when it was opened
+        }
+        ncloses++;
+      }
+      break;
+    case ',':
+      STEP(jsonw_commas);
+      json++;
+      break;
+    case ':':
+      STEP(jsonw_colons);
+      json++;
+      break;
+    default:
+      if ((json = jsonw_primitive_n(&type, end, json)) == NULL)
+        ok = false;
+      else if (type == JSONW_STRING)
+        STEP(jsonw_strings);
+      else
+        STEP(jsonw_values);
+    }
+  }
+
+  // fit the piece onto the ones before it, in order
+  pthread_mutex_lock(&whole->lock);
+  while (whole->turn != piece->idx)
+    pthread_cond_wait(&whole->cond, &whole->lock);
+  unsigned char *levels = whole->levels;
+  ok = ok && whole->ok && whole->to == from &&
+       (ptrdiff_t)whole->depth - 1 + peak <= JSONW_MAX_DEPTH;
+  for (size_t i = 0; ok && i < ncloses; i++)
+    ok = closes[i] >> levels[--whole->depth] & 1;
+  if (ok)
+    ok = (levels[whole->depth - 1] = map[levels[whole->depth - 1]]) != BAD;
+  if (ok)
+    memcpy(levels + whole->depth, opens, nopens), whole->depth += nopens;
+  whole->ok = ok, whole->to = json;
+  whole->turn++;
+  pthread_cond_broadcast(&whole->cond);
+  pthread_mutex_unlock(&whole->lock);
+  return NULL;
+}
+
+char *jsonw_text_par(jsonw_ty *type, int threads, char *end, char *json) {
+  if (threads > JSONW_MAX_THREADS)
+    threads = JSONW_MAX_THREADS;
+  if (threads < 1)
+    threads = 1;
+  // pieces are at least `MIN_CHUNK` bytes each
+  size_t size = end - json;
+  if ((size_t)threads > size / MIN_CHUNK)
+    threads = (int)(size / MIN_CHUNK);
+  char *first = jsonw_ws_n(end, json);
+  // a text that isn't an array or an object is a single token
+  if (threads < 2 || first == end || *first != '[' && *first != '{')
+    return jsonw_text_n(type, end, json);
+
+  // split the text into pieces of about the same size, none of which starts
+  // right after a backslash, so that no escape sequence spans two pieces.
+  // then find out which pieces start within strings
+  jsonw_piece pieces[JSONW_MAX_THREADS];
+  jsonw_whole whole = {.end = end, .to = first, .ok = true, .depth = 1,
+                       .levels = {TOP_VALUE}};
+  char *split = json;
+  for (int i = 0; i < threads; i++) {
+    if (split < json + size / threads * i)
+      split = json + size / threads * i;
+    while (split != end && split != json && split[-1] == '\\')
+      split++;
+    pieces[i] = (jsonw_piece){.json = split, .idx = i, .whole = &whole};
+    if (i)
+      pieces[i - 1].end = split;
+  }
+  pieces[threads - 1].end = end;
+  jsonw_runall(jsonw_quotes, pieces, sizeof(*pieces), threads);
+  for (int i = 0, quoted = false; i < threads; i++) {
+    bool toggles = pieces[i].quoted;
+    pieces[i].quoted = quoted, quoted ^= toggles;
+  }
+
+  pthread_mutex_init(&whole.lock, NULL);
+  pthread_cond_init(&whole.cond, NULL);
+  jsonw_runall(jsonw_piecewise, pieces, sizeof(*pieces), threads);
+  pthread_cond_destroy(&whole.cond);
+  pthread_mutex_destroy(&whole.lock);
+
+  // the pieces of a text fit together into a single value. anything else
+  // has `jsonw_text_n` find out where it stops
+  if (!whole.ok || whole.to != end || whole.depth != 1 ||
+      whole.levels[0] != TOP_DONE)
+    return jsonw_text_n(type, end, json);
+  if (type)
+    *type = *first == '[' ? JSONW_ARRAY : JSONW_OBJECT;
+  return end;
+}
@@ -0,0 +1,45 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+// parallel drivers: the only part of JSONW that depends on POSIX threads.
+// include after jsonw.h, and link with bin/jsonw_par.o and `-pthread`
+
+// parallel drivers never start more threads than this
+#ifndef JSONW_MAX_THREADS
+#define JSONW_MAX_THREADS 256
+#endif
+
+// a run of whole records of an NDJSON log, processed by a single thread
+typedef struct {
+  char *json, *end; // the records, including their newlines
+  size_t first;     // index of the first record, set by the time of `emit`
+  size_t len;       // number of records visited so far
+  size_t invalid;   // number of records visited so far that are not texts
+  void *data;       // free for use by `visit` and `emit`
+} jsonw_chunk;
+
+// called for each record from `json` to `end`, on any thread, in order within
+// a chunk. `valid` is whether the record is a JSON text and `chunk->len` is
+// the index of the record within its chunk
+typedef void jsonw_visit(void *ctx, jsonw_chunk *chunk, bool valid, char *end,
+                         char *json);
+// called for each chunk once it is visited, in order, one chunk at a time
+typedef void jsonw_emit(void *ctx, jsonw_chunk *chunk);
+
+// validates the NDJSON log from `json` to `end` on `threads` threads, visiting
+// its records and emitting its chunks if `visit` and `emit` aren't `NULL`.
+// lines of only whitespace aren't records. returns the number of invalid
+// records
+size_t jsonw_ndjson(jsonw_visit *visit, jsonw_emit *emit, void *ctx,
+                    int threads, char *end, char *json);
+
+// same as `jsonw_project_n` on the NDJSON log from `json` to `end`, over
+// ranges of records on `threads` threads, each with a shape of its own
+size_t jsonw_project_par(jsonw_column *cols, jsonw_keys *keys, size_t cap,
+                         int threads, char *end, char *json);
+
+// same as `jsonw_text_n` on the text from `json` to `end`, validated in pieces
+// on `threads` threads. the pieces are fitted together by the levels of
+// nesting they open and close, so texts that aren't valid are parsed again by
+// `jsonw_text_n` to find out where they stop
+char *jsonw_text_par(jsonw_ty *type, int threads, char *end, char *json);
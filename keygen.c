@@ -0,0 +1,142 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// reads key names from stdin, one per line, and writes to stdout a C function
+// `int <argv[1]>(char *end, char *json)` which takes a pointer to the contents
+// of a JSON string literal, as returned by `jsonw_beginstr`, and returns the
+// line number of the matching key from zero, or -1 if no key matches
+
+#define MAX_KEYS 4096
+
+static char *keys[MAX_KEYS];
+static size_t lens[MAX_KEYS];
+
+static void emit_str(char *str, size_t len) {
+  putchar('"');
+  for (size_t i = 0; i < len; i++)
+    if (str[i] >= ' ' && str[i] <= '~' && !strchr("\"\\?", str[i]))
+      putchar(str[i]);
+    else
+      printf("\\%03o", (unsigned char)str[i]);
+  putchar('"');
+}
+
+// whether `key` can appear in a string literal as is
+static bool plain(char *key, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    if ((unsigned char)key[i] < ' ' || key[i] == '"' || key[i] == '\\')
+      return false;
+  return true;
+}
+
+// emits a decision tree telling apart the `n` distinct keys `ids`, all of
+// length `len`, by switching on the byte that splits them the most
+static void emit_tree(int *ids, int n, size_t len, int indent) {
+  if (n == 1) {
+    printf("%*sif (memcmp(json, ", indent, "");
+    emit_str(keys[*ids], len);
+    printf(", %zu) == 0)\n%*sreturn %d;\n", len, indent + 2, "", *ids);
+    return;
+  }
+
+  size_t split = 0;
+  int most = 0;
+  for (size_t i = 0; i < len; i++) {
+    bool seen[256] = {false};
+    int distinct = 0;
+    for (int k = 0; k < n; k++) {
+      unsigned char c = keys[ids[k]][i];
+      distinct += !seen[c], seen[c] = true;
+    }
+    if (distinct > most)
+      split = i, most = distinct;
+  }
+
+  printf("%*sswitch ((unsigned char)json[%zu]) {\n", indent, "", split);
+  bool done[256] = {false};
+  int *sub = malloc(n * sizeof(*sub));
+  for (int k = 0; k < n; k++) {
+    unsigned char c = keys[ids[k]][split];
+    if (done[c])
+      continue;
+    done[c] = true;
+
+    int m = 0;
+    for (int j = k; j < n; j++)
+      if ((unsigned char)keys[ids[j]][split] == c)
+        sub[m++] = ids[j];
+    if (c >= ' ' && c <= '~' && !strchr("'\\", c))
+      printf("%*scase '%c':\n", indent, "", c);
+    else
+      printf("%*scase 0x%02x:\n", indent, "", c);
+    emit_tree(sub, m, len, indent + 2);
+    printf("%*sbreak;\n", indent + 2, "");
+  }
+  printf("%*s}\n", indent, "");
+  free(sub);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2)
+    fprintf(stderr, "usage: %s <function> < keys > matcher.c\n", *argv),
+        exit(EXIT_FAILURE);
+
+  static char line[4096];
+  int n = 0;
+  while (fgets(line, sizeof(line), stdin)) {
+    size_t len = strcspn(line, "\n");
+    if (n == MAX_KEYS)
+      fprintf(stderr, "too many keys\n"), exit(EXIT_FAILURE);
+    for (int k = 0; k < n; k++)
+      if (lens[k] == len && memcmp(keys[k], line, len) == 0)
+        fprintf(stderr, "duplicate key: %.*s\n", (int)len, line),
+            exit(EXIT_FAILURE);
+    if ((keys[n] = malloc(len + 1)) == NULL)
+      perror("malloc"), exit(EXIT_FAILURE);
+    memcpy(keys[n], line, len), keys[n][len] = '\0', lens[n++] = len;
+  }
+
+  printf("// generated by keygen; do not edit\n\n");
+  printf("#include \"jsonw.h\"\n#include <string.h>\n\n");
+  printf("int %s(char *end, char *json) {\n", argv[1]);
+  printf("  if (json == NULL)\n    return -1;\n\n");
+  printf("  char *quote = json;\n");
+  printf("  while (quote != end && *quote != '\"' && *quote != '\\\\' &&\n");
+  printf("         (unsigned char)*quote >= ' ')\n    quote++;\n");
+  printf("  if (quote == end || *quote != '\"') {\n");
+  printf("    // keys with escapes are compared without normalization\n");
+  printf("    static char *keys[] = {\n");
+  for (int k = 0; k < n; k++)
+    printf("        "), emit_str(keys[k], lens[k]), printf(",\n");
+  printf("        NULL,\n    };\n");
+  printf("    for (char **key = keys; *key; key++)\n");
+  printf("      if (jsonw_strcmp_n(*key, end, json) == 0)\n");
+  printf("        return key - keys;\n    return -1;\n  }\n\n");
+
+  // keys that need escaping never match a string literal without escapes
+  printf("  switch (quote - json) {\n");
+  int *ids = malloc((n + 1) * sizeof(*ids));
+  bool *done = calloc(n + 1, sizeof(*done));
+  for (int k = 0; k < n; k++) {
+    int m = 0;
+    for (int j = k; j < n; j++)
+      if (!done[j] && lens[j] == lens[k])
+        if (done[j] = true, plain(keys[j], lens[j]))
+          ids[m++] = j;
+    if (m == 0)
+      continue;
+
+    printf("  case %zu:\n", lens[k]);
+    if (lens[k] == 0)
+      printf("    return %d;\n", ids[0]);
+    else
+      emit_tree(ids, m, lens[k], 4), printf("    break;\n");
+  }
+  printf("  }\n  return -1;\n}\n");
+
+  free(ids), free(done);
+  for (int k = 0; k < n; k++)
+    free(keys[k]);
+}
@@ -1,9 +1,400 @@
 #include "jsonw.h"
+#include "jsonw_par.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  char *buf;
+  size_t len, cap;
+} output;
+
+static bool append(void *ctx, char *buf, size_t len) {
+  output *out = ctx;
+  if (out->len + len > out->cap &&
+      (out->buf = realloc(out->buf, out->cap = (out->len + len) * 2)) == NULL)
+    return false;
+  return memcpy(out->buf + out->len, buf, len), out->len += len, true;
+}
+
+// writes the valid value `json` back out, with strings unescaped into `unesc`
+// first, and checks that its numbers are written the way they read back
+static jsonw_writer *echo(char *unesc, size_t size, char *json,
+                          jsonw_writer *w) {
+  jsonw_ty type;
+  bool b = false;
+  double num, back;
+  char buf[sizeof("-0.0000012345678901234567")], *end;
+  switch (jsonw_value(&type, json), type) {
+  case JSONW_NULL:
+    return jsonw_putnull(w);
+  case JSONW_BOOLEAN:
+    return jsonw_boolean(&b, json), jsonw_putboolean(b, w);
+  case JSONW_NUMBER:
+    jsonw_number(&num, json);
+    if ((end = jsonw_dtoa(buf, num)) &&
+        (jsonw_number(&back, buf) != end || memcmp(&back, &num, sizeof(num))))
+      printf("number does not round-trip: %s\n", buf);
+    return jsonw_putnumber(num, w);
+  case JSONW_STRING:
+    jsonw_unescape(unesc, size, json + 1);
+    return jsonw_putstring(unesc, w);
+  case JSONW_ARRAY:
+    w = jsonw_putbeginarr(w);
+    for (char *elem = jsonw_beginarr(json); elem; elem = jsonw_element(elem))
+      w = echo(unesc, size, elem, w);
+    return jsonw_putendarr(w);
+  case JSONW_OBJECT:
+    w = jsonw_putbeginobj(w);
+    for (char *memb = jsonw_beginobj(json); memb; memb = jsonw_member(memb)) {
+      jsonw_unescape(unesc, size, memb + 1);
+      w = echo(unesc, size, jsonw_name(memb), jsonw_putname(unesc, w));
+    }
+    return jsonw_putendobj(w);
+  }
+  return NULL;
+}
+
+// counts the matches of each path
+static void tally(void *ctx, size_t path, char *json) {
+  ((size_t *)ctx)[path]++;
+}
+
+// whether row `row` of the `n` columns `cols` holds the values at `vals`
+// where they are of the type of their column, and missing values elsewhere
+static bool holds(jsonw_column *cols, size_t n, size_t row, char **vals) {
+  for (size_t i = 0; i < n; i++) {
+    jsonw_column *col = cols + i;
+    jsonw_span span = {NULL}, *s;
+    double d;
+    int64_t i64;
+    bool ok = col->valid[row / 8] >> row % 8 & 1, agree = true;
+    switch (col->type) {
+    case JSONW_COL_DOUBLE:
+      agree = ok == !!jsonw_number(&d, vals[i]) &&
+              (!ok || memcmp(&d, (double *)col->vals + row, sizeof(d)) == 0);
+      break;
+    case JSONW_COL_INT64:
+      agree = ok == !!jsonw_int64(&i64, vals[i]) &&
+              (!ok || i64 == ((int64_t *)col->vals)[row]);
+      break;
+    case JSONW_COL_SPAN:
+      s = (jsonw_span *)col->vals + row;
+      agree = ok == !!jsonw_rawstr(&span.len, &span.esc, vals[i]) &&
+              (!ok || s->str == vals[i] + 1 && s->len == span.len &&
+                          s->esc == span.esc);
+      break;
+    }
+    if (!agree)
+      return false;
+  }
+  return true;
+}
+
+// escapes `str` into `buf` a character at a time, as `jsonw_escape` does
+static char *escape(char *buf, size_t size, char *str) {
+  for (char *end = buf + size; *str && end - buf >= sizeof("\\u0000"); str++)
+    buf = jsonw_quote(buf, *str);
+  return *buf = '\0', str;
+}
+
+// writes all of what `fn` makes of `json` through a buffer of `size` bytes into
+// `out`, resuming from where it stops until it no longer moves on
+static char *resume(char *(*fn)(char *, size_t, char *), char *out,
+                    size_t size, char *json) {
+  for (char *next; (next = fn(out, size, json)) != json; json = next)
+    out += strlen(out);
+  return json;
+}
+
+// checks that long strings come out the same through small buffers, resumed
+// from where they stop, as through a buffer big enough for all of them
+static void resumes(void) {
+  size_t len = 256 * 1024;
+  char *strs[2], *out = malloc(len * 6 + 1), *ref = malloc(len * 6 + 1);
+  for (int i = 0; i < 2; i++) {
+    strs[i] = malloc(len + 1);
+    for (size_t j = 0; j < len; j++)
+      strs[i][j] = i == 0 ? "a/"[j % 2] : j % 1000 == 999 ? '"' : 'x';
+    strs[i][len] = '\0';
+  }
+  size_t sizes[] = {7, 8, 13, 64};
+  for (int i = 0; i < 2; i++) {
+    escape(ref, len * 6 + 1, strs[i]);
+    for (size_t j = 0; j < sizeof(sizes) / sizeof(*sizes); j++)
+      if (*resume(jsonw_escape, out, sizes[j], strs[i]) || strcmp(out, ref))
+        printf("resumed escape disagrees (%zu)\n", sizes[j]);
+  }
+  free(strs[0]), free(strs[1]);
+
+  // the contents of a long string literal, with escapes here and there
+  char *lit = malloc(len + 1), *quote = lit + len - 1;
+  char *escs[] = {"\\n", "\\/", "\\\"", "\\u0041"};
+  memset(lit, 'x', len);
+  for (size_t j = 0; j + 16 < len; j += 997)
+    memcpy(lit + j, escs[j / 997 % 4], strlen(escs[j / 997 % 4]));
+  *quote = '"', lit[len] = '\0';
+  jsonw_unescape(ref, len + 1, lit);
+  for (size_t j = 0; j < sizeof(sizes) / sizeof(*sizes); j++)
+    if (resume(jsonw_unescape, out, sizes[j], lit) != quote || strcmp(out, ref))
+      printf("resumed unescape disagrees (%zu)\n", sizes[j]);
+  // decoding takes escapes beyond ASCII too, which `jsonw_unescape` doesn't
+  for (size_t j = 997 * 3; j + 16 < len; j += 997 * 4)
+    memcpy(lit + j, "\\ud83d\\ude00", 12);
+  jsonw_decode(ref, len + 1, lit);
+  for (size_t j = 0; j < sizeof(sizes) / sizeof(*sizes); j++)
+    if (resume(jsonw_decode, out, sizes[j], lit) != quote || strcmp(out, ref))
+      printf("resumed decode disagrees (%zu)\n", sizes[j]);
+  free(lit), free(out), free(ref);
+}
+
+// what `jsonw_ndjson` sees of a log, chunk by chunk
+typedef struct {
+  char *next; // where the next chunk is due to start
+  size_t chunks, records, invalid;
+  bool agree;
+} emitted;
+
+// records come in order within their chunk, and are valid when they are texts
+static void visit(void *ctx, jsonw_chunk *chunk, bool valid, char *end,
+                  char *json) {
+  // the end of the last record, or the chunk itself once it disagrees
+  if (chunk->data == chunk)
+    return;
+  bool agree = json >= chunk->json && end <= chunk->end &&
+               json >= (char *)chunk->data &&
+               valid == (jsonw_text_n(NULL, end, json) == end);
+  chunk->data = agree ? (void *)end : chunk;
+}
+
+// chunks come in order, one after the other, and so do their records
+static void emit(void *ctx, jsonw_chunk *chunk) {
+  emitted *em = ctx;
+  em->agree &= chunk->json == em->next && chunk->first == em->records &&
+               chunk->data != chunk;
+  em->next = chunk->end, em->chunks++;
+  em->records += chunk->len, em->invalid += chunk->invalid;
+}
+
+// checks documents and NDJSON logs against what they are made of
+static void documents(void) {
+  // concatenated texts are documents, one after the other
+  char *docs = " 1 [2, 3]\n{\"a\": \"x\\ny\"}null\"s\" ", *doc = jsonw_ws(docs);
+  size_t len = 0;
+  for (; doc && *doc; doc = jsonw_document(doc))
+    len++;
+  // the last document ends where the texts do, and an invalid one is reported
+  // as such, even last
+  char *bad = "[1] [2,", *next = bad;
+  size_t bads = 0;
+  for (; next && *next; next = jsonw_document(next))
+    bads++;
+  if (len != 5 || doc != docs + strlen(docs) ||
+      jsonw_document_n(docs + 12, docs + 3) != docs + 10 ||
+      jsonw_document_n(docs + 10, docs + 3) != docs + 10 || bads != 2 ||
+      next != NULL || jsonw_document(bad) != bad + 4)
+    printf("documents disagree\n");
+
+  // a log of a few chunks, with lines of only whitespace, which aren't
+  // records, newlines escaped in strings, which are fine, and newlines within
+  // strings, which split records into two invalid ones
+  char *lines[] = {"{\"id\": 1, \"ok\": true}", " \t ", "",
+                   "{\"msg\": \"a\\nb\"}", "{\"msg\": \"a\nb\"}", "[1,",
+                   "[1, 2]"};
+  size_t n = sizeof(lines) / sizeof(*lines), cycles = 4000;
+  char *log = malloc(cycles * 128), *end = log;
+  for (size_t i = 0; i < cycles * n; i++)
+    end += sprintf(end, "%s\n", lines[i % n]);
+  emitted em = {.next = log, .agree = true};
+  size_t invalid = jsonw_ndjson(visit, emit, &em, 3, end, log);
+  if (invalid != cycles * 3 || em.invalid != invalid ||
+      em.records != cycles * 6 || em.chunks < 2 || em.next != end ||
+      !em.agree || jsonw_ndjson(NULL, NULL, NULL, 1, end, log) != invalid)
+    printf("NDJSON log disagrees\n");
+  // a last record without a newline is a record all the same
+  end[-1] = ' ', em = (emitted){.next = log, .agree = true};
+  if (jsonw_ndjson(visit, emit, &em, 2, end, log) != invalid ||
+      em.records != cycles * 6 || !em.agree)
+    printf("NDJSON log disagrees on its last line\n");
+  free(log);
+}
+
+// whether row `row` of the `n` columns `cols` and `refs` agree, values and all
+static bool agree(jsonw_column *cols, jsonw_column *refs, size_t n,
+                  size_t row) {
+  for (size_t i = 0; i < n; i++) {
+    jsonw_column *col = cols + i, *ref = refs + i;
+    bool ok = col->valid[row / 8] >> row % 8 & 1;
+    if (ok != (ref->valid[row / 8] >> row % 8 & 1))
+      return false;
+    jsonw_span *s = (jsonw_span *)col->vals + row;
+    jsonw_span *r = (jsonw_span *)ref->vals + row;
+    if (ok && (col->type == JSONW_COL_DOUBLE
+                   ? memcmp((double *)col->vals + row,
+                            (double *)ref->vals + row, sizeof(double))
+               : col->type == JSONW_COL_INT64
+                   ? ((int64_t *)col->vals)[row] != ((int64_t *)ref->vals)[row]
+                   : s->str != r->str || s->len != r->len || s->esc != r->esc))
+      return false;
+  }
+  return true;
+}
+
+// checks projecting NDJSON logs over ranges of records on several threads
+// against projecting them on one, for logs of fewer records than threads,
+// lines that aren't records or aren't objects, and fewer rows than records
+static void projections(void) {
+  char *lines[] = {"{\"id\": 1, \"x\": 2.5, \"s\": \"a\\nb\"}", "", " \t",
+                   "[1, 2]", "{\"s\": \"t\", \"id\": \"no\"}", "null",
+                   "{\"x\": -3, \"id\": 7} x", "{\"x\": 1e3}"};
+  char *names[] = {"x", "id", "s"};
+  jsonw_keys keys;
+  jsonw_hashkeys(&keys, names, 3);
+  size_t n = sizeof(lines) / sizeof(*lines), most = 3000;
+  char *log = malloc(most * 64);
+  double dbls[2][3000];
+  int64_t ints[2][3000];
+  jsonw_span spans[2][3000];
+  unsigned char bits[2][3][3000 / 8];
+  jsonw_column cols[2][3];
+  for (int i = 0; i < 2; i++) {
+    cols[i][0] = (jsonw_column){JSONW_COL_DOUBLE, dbls[i], bits[i][0]};
+    cols[i][1] = (jsonw_column){JSONW_COL_INT64, ints[i], bits[i][1]};
+    cols[i][2] = (jsonw_column){JSONW_COL_SPAN, spans[i], bits[i][2]};
+  }
+  size_t counts[] = {0, 1, 2, 5, 13, 40, most};
+  for (size_t c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+    char *end = log;
+    for (size_t i = 0; i < counts[c]; i++)
+      end += sprintf(end, "%s%s", i ? "\n" : "", lines[(i * 5 + c) % n]);
+    jsonw_shape shape = {.keys = &keys};
+    memset(bits[1], 0, sizeof(bits[1]));
+    size_t len = jsonw_project_n(cols[1], &shape, most, end, log);
+    size_t caps[] = {len, len / 2, 3, 0};
+    for (size_t k = 0; k < sizeof(caps) / sizeof(*caps); k++)
+      for (int threads = 1; threads <= 9; threads += 2) {
+        memset(bits[0], 0, sizeof(bits[0]));
+        size_t cap = caps[k], rows = cap < len ? cap : len;
+        bool same =
+            jsonw_project_par(cols[0], &keys, cap, threads, end, log) == len;
+        for (size_t row = 0; same && row < rows; row++)
+          same = agree(cols[0], cols[1], 3, row);
+        if (!same)
+          printf("parallel projection disagrees (%zu lines, %zu rows, "
+                 "%d threads)\n",
+                 counts[c], cap, threads);
+      }
+  }
+  free(log);
+}
+
+// whether validating `json` in pieces agrees with validating it as a whole,
+// for any number of threads, even none or fewer
+static bool whole(char *end, char *json) {
+  jsonw_ty type = -1, ref = -1;
+  char *res = jsonw_text_n(&ref, end, json);
+  for (int threads = -1; threads <= 5; threads++)
+    if (jsonw_text_par(&type, threads, end, json) != res || res && type != ref)
+      return false;
+  return true;
+}
+
+// checks validating a text too big for a single piece against validating it
+// as a whole, valid, cut short and with bytes changed
+static void pieces(void) {
+  // strings of runs of backslashes, some of them escaping quotes, are bound
+  // to span the splits between pieces
+  char *elems[] = {
+      "\"ab\\\\\\\\\\\"cd\\\\\"",
+      "{\"k\\\\\": [1, -2.5e3, true]}",
+      "\"\\\"\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\u00e9\"",
+      "[[], {}, null]",
+  };
+  size_t n = sizeof(elems) / sizeof(*elems), count = 12000;
+  char *json = malloc(count * 64), *end = json;
+  *end++ = '[';
+  for (size_t i = 0; i < count; i++)
+    end += sprintf(end, "%s%s", i ? ",\n" : "", elems[i % n]);
+  *end++ = ']';
+  size_t size = end - json;
+  if (!whole(end, json) || jsonw_text_n(NULL, end, json) != end)
+    printf("pieces disagree\n");
+
+  for (size_t i = 1; i < 8; i++)
+    if (!whole(json + size / 8 * i, json))
+      printf("pieces disagree on a cut at %zu\n", size / 8 * i);
+  // change bytes around the splits between pieces, and elsewhere
+  char chrs[] = "\"\\]}[{,: x0";
+  for (size_t i = 0, pos = 1; i < 100; i++) {
+    pos = (pos * 1103515245 + 12345) % size;
+    size_t at = i % 2 ? pos : size / (2 + i % 4) * (1 + i % 3) - 8 + i % 16;
+    char old = json[at % size];
+    json[at % size] = chrs[i % (sizeof(chrs) - 1)];
+    if (!whole(end, json))
+      printf("pieces disagree on a change at %zu\n", at % size);
+    json[at % size] = old;
+  }
+  free(json);
+}
 
 int main(int argc, char **argv) {
-  char *buf = NULL;
+  char *buf = NULL, *copy = NULL, *unesc = NULL;
+  output out = {NULL}, again = {NULL};
+  // a shape is learned from and checked against every object in turn
+  char *names[] = {"a", "", "id", "x", "min", "max", "title", "\xc3\xa9"};
+  jsonw_keys keys;
+  jsonw_hashkeys(&keys, names, sizeof(names) / sizeof(*names));
+  jsonw_shape shape = {.keys = &keys};
+  // paths compiled into a single buffer, one program after the other
+  char *paths[] = {"", "[0]", "[1]", "a", "[*]", "*", "[0].a", "[*][*]"};
+  char prog[256], *progs[8], *pc = prog;
+  for (int i = 0; i < 8; i++)
+    progs[i] = pc, pc = jsonw_compile(pc, prog + sizeof(prog) - pc, paths[i]);
+
+  // escaping in bulk writes the same characters, and stops at the same place,
+  // as escaping a character at a time, whatever the size of the buffer
+  char *strs[] = {"a/b/c/d/e/f/gh", "plain text that needs no escaping at all",
+                  "tab\there \"quoted\" back\\slash\x01\x1f end",
+                  "\xc3\xa9t\xc3\xa9 //// \n\r\b\f"};
+  for (size_t i = 0; i < sizeof(strs) / sizeof(*strs); i++)
+    for (size_t size = 1; size < 64; size++) {
+      char esc[64], ref[64];
+      if (jsonw_escape(esc, size, strs[i]) != escape(ref, size, strs[i]) ||
+          strcmp(esc, ref) != 0)
+        printf("escape disagrees: %s (%zu)\n", strs[i], size);
+    }
+
+  // writers without a buffer to write from fail rather than write nothing
+  jsonw_writer nobuf = {.buf = NULL, .size = 0, .write = append, .ctx = &out};
+  if (jsonw_putnull(&nobuf) != NULL || out.len != 0)
+    printf("writer without a buffer disagrees\n");
+
+  // empty arrays have no runs, and arrays of only structured elements have
+  // the same runs found through the index or not
+  char *none[1], *nested = "[[1], {\"a\": 2}, [3, 4], {}, [[5]], [\"]\"]]";
+  if (jsonw_split(none, 4, "[]") || jsonw_split_n(none, 4, NULL, " [ ] ") ||
+      jsonw_split(none, 0, "[1]"))
+    printf("split disagrees on empty arrays\n");
+  jsonw_mark nmarks[32];
+  jsonw_sidx nsidx;
+  jsonw_structure(&nsidx, nmarks, 32, NULL, nested);
+  for (size_t n = 1; n <= 8; n++) {
+    char *runs[8], *iruns[8];
+    size_t len = jsonw_split(runs, n, nested);
+    if (len == 0 || len > n || len > 6 ||
+        jsonw_split_i(iruns, n, &nsidx, nested) != len ||
+        memcmp(runs, iruns, len * sizeof(*runs)) != 0)
+      printf("split disagrees on nested arrays (%zu)\n", n);
+  }
+
+  resumes();
+  documents();
+  projections();
+  pieces();
+
+  jsonw_mark *marks = NULL;
+  jsonw_entry *ents = NULL;
+  jsonw_slot *slots = NULL;
   while (*++argv) {
     // printf("parsing %s\n", *argv);
 
@@ -26,11 +417,253 @@ int main(int argc, char **argv) {
 
     char *end = jsonw_text(NULL, buf);
     bool valid = end && end - buf == size;
+    if (jsonw_text_n(NULL, buf + size, buf) != end)
+      printf("bounded parse disagrees: %s\n", *argv);
+
+    jsonw_sidx sidx;
+    marks = realloc(marks, (size + 1) * sizeof(*marks));
+    if (valid && !(jsonw_structure(&sidx, marks, size + 1, buf + size, buf) &&
+                   jsonw_ws_n(buf + size, jsonw_value_i(NULL, &sidx,
+                                                        jsonw_ws(buf))) == end))
+      printf("indexed parse disagrees: %s\n", *argv);
+    if (valid && jsonw_ws(jsonw_value_u(NULL, NULL, jsonw_ws(buf))) != end)
+      printf("unchecked parse disagrees: %s\n", *argv);
+    // unchecked parsers stop at the end of texts cut short within a structured
+    // value rather than read past them
+    copy = realloc(copy, size + 1), unesc = realloc(unesc, size + 1);
+    char *top = jsonw_ws(buf), *last = valid ? end : top;
+    while (last > top && strchr(" \t\n\r", last[-1]))
+      last--; // past the closing bracket of valid texts
+    for (char *cut = top + 1; cut < last && (*top == '[' || *top == '{');
+         cut += (last - top) / 2 ? (last - top) / 2 : 1) {
+      memcpy(copy, buf, cut - buf), copy[cut - buf] = '\0';
+      if (jsonw_value_u(NULL, NULL, copy) != NULL)
+        printf("truncated unchecked parse disagrees: %s\n", *argv);
+    }
+
+    // raw strings are strings, escapes or not. test suite strings are mostly
+    // the first element of an array
+    size_t len = 0;
+    bool esc = false;
+    char *str = jsonw_beginarr(buf) ? jsonw_beginarr(buf) : jsonw_ws(buf);
+    if (jsonw_rawstr(&len, &esc, str) != jsonw_string(NULL, str) ||
+        jsonw_string(NULL, str) && (str[1 + len] != '"' ||
+                                    esc != !!memchr(str + 1, '\\', len)))
+      printf("raw string parse disagrees: %s\n", *argv);
+
+    // subscripting through a cursor agrees with subscripting from scratch, in
+    // increasing order or not, and finds the end of the array along the way
+    jsonw_cursor cur;
+    size_t elems = 0, count = 0;
+    char *arr = jsonw_array(&elems, buf);
+    if (arr && jsonw_begincur(&cur, buf)) {
+      bool agree = true;
+      for (size_t i = 0; i < elems; i++)
+        agree &= jsonw_at(i, &cur) == jsonw_index(i, cur.first);
+      agree &= jsonw_at(elems, &cur) == NULL && cur.len == elems;
+      agree &= !elems || jsonw_at(elems / 2, &cur) ==
+                             jsonw_index(elems / 2, cur.first);
+      if (!agree || jsonw_endcur(&count, &cur) != arr || count != elems)
+        printf("cursor parse disagrees: %s\n", *argv);
+    }
+
+    // runs start at elements, in order, one per element at most. runs found
+    // through the index start at structured elements, so on arrays of only
+    // those they are the same
+    char **runs = malloc((elems + 5) * sizeof(*runs));
+    char **iruns = malloc((elems + 5) * sizeof(*iruns));
+    bool structs = true;
+    for (char *e = jsonw_beginarr(buf); e; e = jsonw_element(e))
+      structs &= *e == '[' || *e == '{';
+    for (size_t n = 0; arr && valid && n <= elems + 4; n += 1 + elems / 8) {
+      size_t len = jsonw_split(runs, n, buf), j = 0, k = 0;
+      size_t ilen = jsonw_split_i(iruns, n, &sidx, buf);
+      for (char *e = jsonw_beginarr(buf); e; e = jsonw_element(e))
+        j += j < len && runs[j] == e, k += k < ilen && iruns[k] == e;
+      if (j != len || k != ilen || len > n || len > elems ||
+          (len == 0) != (n == 0 || elems == 0) ||
+          jsonw_split_n(iruns, n, buf + size, buf) != len ||
+          memcmp(iruns, runs, len * sizeof(*runs)) != 0 ||
+          structs && (jsonw_split_i(iruns, n, &sidx, buf) != len ||
+                      memcmp(iruns, runs, len * sizeof(*runs)) != 0))
+        printf("split disagrees: %s (%zu)\n", *argv, n);
+    }
+    free(runs), free(iruns);
+
+    // a tape parses texts the way `jsonw_text` does, and values found through
+    // it, with key tables or without, are those found by walking the text
+    ents = realloc(ents, (size + 1) * sizeof(*ents));
+    slots = realloc(slots, (size + 1) * sizeof(*slots));
+    for (int i = 0; i < 2; i++) {
+      jsonw_tape tape = {.ents = ents, .cap = size + 1,
+                         .slots = i ? slots : NULL, .slotcap = size + 1};
+      bool agree = jsonw_build(&tape, buf + size, buf) == end;
+      jsonw_entry *root = valid ? jsonw_entryat(&tape, buf) : NULL;
+      agree &= !valid || root && root == ents && root->size == tape.len;
+      if (root && arr)
+        for (size_t j = 0; j <= elems; j++)
+          agree &= jsonw_index_t(j, &tape, buf) ==
+                   (j < elems ? jsonw_index(j, jsonw_beginarr(buf)) : NULL);
+      if (root && root->type == JSONW_OBJECT)
+        for (size_t j = 0; j < sizeof(names) / sizeof(*names); j++)
+          agree &= jsonw_lookup_t(names[j], &tape, buf) ==
+                   jsonw_lookup(names[j], jsonw_beginobj(buf));
+      if (!agree)
+        printf("tape parse disagrees: %s\n", *argv);
+    }
+
+    // looking up values through a shape agrees with looking them up from
+    // scratch, on the first and the next object of the same shape
+    char *obj = jsonw_beginobj(buf);
+    for (int i = 0; i < 4; i++) {
+      char *vals[8] = {NULL}, *refs[8] = {NULL};
+      if (jsonw_shaped(vals, &shape, i % 2, obj) !=
+              jsonw_lookups(refs, &keys, i % 2, obj) ||
+          memcmp(vals, refs, sizeof(vals)) != 0)
+        printf("shaped lookup disagrees: %s\n", *argv);
+    }
+
+    // queries match what walking the text by hand does, parsing it as a whole
+    char *matches[8] = {NULL}, *root = jsonw_ws(buf);
+    char *elem = jsonw_beginarr(buf);
+    size_t tallies[8] = {0}, members = 0;
+    char *q = jsonw_query(matches, progs, 8, buf);
+    if (q != jsonw_value(NULL, root) ||
+        jsonw_queryall(tally, tallies, progs, 8, buf) != q)
+      printf("query parse disagrees: %s\n", *argv);
+    jsonw_object(&members, buf);
+    if (q && (matches[0] != root || tallies[0] != 1 ||
+              matches[1] != (arr && elems ? elem : NULL) ||
+              matches[2] != (arr && elems > 1 ? jsonw_index(1, elem) : NULL) ||
+              matches[3] != jsonw_lookup("a", jsonw_beginobj(buf)) ||
+              tallies[4] != (arr ? elems : 0) ||
+              tallies[5] != (*root == '{' ? members : 0) ||
+              matches[6] != jsonw_lookup("a", jsonw_beginobj(matches[1]))))
+      printf("query disagrees: %s\n", *argv);
+
+    // decoding arrays of only numbers agrees with decoding each element
+    double nums[8];
+    int64_t int64s[8];
+    size_t nlen = 0, ilen = 0;
+    char *dall = jsonw_numbers(nums, 8, &nlen, buf);
+    char *iall = jsonw_int64s(int64s, 8, &ilen, buf);
+    bool dnum = arr && elems <= 8, inum = dnum;
+    for (size_t i = 0; arr && i < elems && i < 8; i++) {
+      char *elem = jsonw_index(i, jsonw_beginarr(buf));
+      double d;
+      int64_t i64;
+      dnum &= jsonw_number(&d, elem) && (!dall || !memcmp(&d, nums + i, 8));
+      inum &= jsonw_int64(&i64, elem) && (!iall || i64 == int64s[i]);
+    }
+    if (dall != (dnum ? arr : NULL) || dall && nlen != elems ||
+        iall != (inum ? arr : NULL) || iall && ilen != elems)
+      printf("number array parse disagrees: %s\n", *argv);
+
+    // projecting the elements of an array, or the text as a single record,
+    // agrees with looking up the values of each
+    double dbls[8];
+    int64_t ints[8];
+    jsonw_span spans[8];
+    unsigned char bits[8][1];
+    jsonw_column cols[8];
+    for (int i = 0; i < 8; i++)
+      cols[i] = (jsonw_column){i % 3, i % 3 == 0   ? (void *)dbls
+                                      : i % 3 == 1 ? (void *)ints
+                                                   : (void *)spans,
+                               bits[i]};
+    size_t recs = jsonw_projectarr(cols, &shape, 8, buf);
+    if (arr && valid && recs != elems)
+      printf("projection disagrees: %s\n", *argv);
+    for (size_t i = 0; i < recs && i < 8; i++) {
+      char *vals[8] = {NULL}, *elem = jsonw_index(i, jsonw_beginarr(buf));
+      char *obj = jsonw_beginobj(elem);
+      if (!jsonw_endobj(jsonw_lookups(vals, &keys, false, obj)))
+        memset(vals, 0, sizeof(vals));
+      if (!holds(cols, 8, i, vals))
+        printf("projection disagrees: %s[%zu]\n", *argv, i);
+    }
+    if (!memchr(buf, '\n', size) && jsonw_project(cols, &shape, 8, buf)) {
+      char *vals[8] = {NULL};
+      char *obj = jsonw_beginobj(buf);
+      if (jsonw_endobj(jsonw_lookups(vals, &keys, false, obj)) != buf + size)
+        memset(vals, 0, sizeof(vals));
+      if (!holds(cols, 8, 0, vals))
+        printf("projection disagrees: %s\n", *argv);
+    }
+
+    // in-place unescaping decodes what unescaping does, and minifying keeps
+    // texts valid and at most as long
+    memcpy(copy, buf, size + 1);
+    char *lit = copy + (str - buf), *unq = jsonw_unquote(&len, lit);
+    char *ref = jsonw_string(NULL, str);
+    if (!unq != !ref ||
+        unq && (unq - copy != ref - buf ||
+                jsonw_unescape(unesc, size + 1, str + 1) != ref - 1 ||
+                memcmp(lit, unesc, len + 1) != 0))
+      printf("in-place unescape disagrees: %s\n", *argv);
+    // decoding to UTF-8 never takes more room than the literal
+    if (ref && jsonw_decode(unesc, size + 1, str + 1) != ref - 1)
+      printf("decode disagrees: %s\n", *argv);
+    memcpy(copy, buf, size + 1);
+    char *min = jsonw_minify_n(copy + size, copy);
+    if (valid && (jsonw_text_n(NULL, min, copy) != min ||
+                  jsonw_minify_n(min, copy) != min))
+      printf("minified parse disagrees: %s\n", *argv);
+
+    // writing a text back out through a tiny buffer gives a text that is
+    // written back out the same. numbers out of range have no representation
+    char wbuf[7];
+    jsonw_writer w = {.buf = wbuf, .size = sizeof(wbuf), .write = append,
+                      .ctx = &out};
+    jsonw_writer w2 = {.buf = wbuf, .size = sizeof(wbuf), .write = append,
+                       .ctx = &again};
+    out.len = again.len = 0;
+    if (valid && jsonw_flush(echo(unesc, size + 1, jsonw_ws(buf), &w)) &&
+        (!append(&out, "", 1) ||
+         jsonw_text(NULL, out.buf) != out.buf + out.len - 1 ||
+         !jsonw_flush(echo(unesc, size + 1, out.buf, &w2)) ||
+         again.len != out.len - 1 || memcmp(again.buf, out.buf, again.len)))
+      printf("written text disagrees: %s\n", *argv);
+
+    // feed the text a byte at a time, then mark the end of input
+    jsonw_stream st = {0};
+    char *fed = buf;
+    for (char *chunk = buf; fed == chunk; chunk++)
+      fed = jsonw_feed(&st, chunk + (chunk != buf + size), chunk);
+    if (fed != end)
+      printf("streamed parse disagrees: %s\n", *argv);
+    // texts that must be accepted are valid UTF-8, and with string literals
+    // validated, texts that are accepted are too
+    bool utf8 = jsonw_utf8_n(buf + size, buf) != NULL;
+    if (**argv == 'y' && !utf8)
+      printf("UTF-8 validation failed: %s\n", *argv);
+#ifdef JSONW_VALIDATE_UTF8
+    if (valid && !utf8)
+      printf("UTF-8 validation disagrees: %s\n", *argv);
+#endif
+#ifdef JSONW_STATS
+    // counters see the single text parsed since they were reset, including
+    // its nesting if it is structured
+    char dump[1024];
+    jsonw_resetstats();
+    jsonw_text(NULL, buf);
+    jsonw_stats *stats = jsonw_getstats();
+    jsonw_counter *text = stats->parsers + JSONW_STAT_TEXT;
+    if (text->calls != 1 || text->fails != !end ||
+        text->bytes != (end ? end - buf : 0) || valid && stats->depth == 0 &&
+                                                    jsonw_structured(NULL, buf))
+      printf("counters disagree: %s\n", *argv);
+    if (jsonw_dumpstats(NULL, 0) != jsonw_dumpstats(dump, sizeof(dump)) ||
+        strlen(dump) != jsonw_dumpstats(NULL, 0))
+      printf("counter dump disagrees: %s\n", *argv);
+#endif
     if (**argv == 'y' && !valid || **argv == 'n' && valid)
       printf("test failed: %s:\n%s\n", *argv, buf);
     if (**argv != 'y' && **argv != 'n' && **argv != 'i')
       printf("invalid test: %s\n", *argv);
   }
 
-  free(buf);
+  free(buf), free(copy), free(unesc), free(marks);
+  free(ents), free(slots);
+  free(out.buf), free(again.buf);
 }
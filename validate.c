@@ -0,0 +1,209 @@
+#define _POSIX_C_SOURCE 200809L
+#include "jsonw.h"
+#include "jsonw_par.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// usage: bin/validate [-t threads] [file.json ...]
+//
+// validates every file given, or every file named on a line of stdin if none
+// is, on `threads` threads. files whose names start with `y_` must be valid
+// texts and files whose names start with `n_` must not, as in JSONTestSuite;
+// files whose names start with `i_` may be either, and all other files must be
+// valid. prints a line per file that isn't as expected, in order, then a
+// summary to stderr. exits with failure if any file isn't as expected
+
+// files smaller than this are read into a buffer, as mapping them into memory
+// costs more than copying them
+#define MIN_MAP (64 * 1024)
+
+typedef enum { VALID, INVALID, UNREADABLE } verdict;
+
+typedef struct {
+  char *path;
+  verdict verdict;
+  int err; // `errno` of unreadable files
+  size_t size;
+  bool done;
+} file;
+
+typedef struct {
+  file *files;
+  size_t len, claimed, printed;
+  size_t valid, invalid, unreadable, failed, bytes;
+  int threads; // threads for a single file, if only one is given
+  pthread_mutex_t lock;
+} batch;
+
+// whether the name of the file starts with `prefix`, as JSONTestSuite names
+static bool named(file *file, char *prefix) {
+  char *name = strrchr(file->path, '/');
+  return strncmp(name ? name + 1 : file->path, prefix, 2) == 0;
+}
+
+// whether the text of the file is as its name says it should be
+static bool expected(file *file) {
+  if (file->verdict == VALID)
+    return !named(file, "n_");
+  if (file->verdict == INVALID)
+    return named(file, "n_") || named(file, "i_");
+  return false;
+}
+
+static void validate(batch *batch, file *file, char *buf) {
+  int fd = open(file->path, O_RDONLY);
+  struct stat st;
+  if (fd == -1 || fstat(fd, &st) == -1) {
+    file->verdict = UNREADABLE, file->err = errno;
+    if (fd != -1)
+      close(fd);
+    return;
+  }
+
+  // texts are parsed bounded, so neither buffers nor maps need a terminator
+  char *json = buf, *map = NULL;
+  size_t size = file->size = st.st_size;
+  ssize_t got = 0, n = 0;
+  if (size >= MIN_MAP) {
+    if ((map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)
+      map = NULL, n = -1;
+    else
+      json = map, got = size, posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+  } else
+    while (got < size && (n = read(fd, buf + got, size - got)) > 0)
+      got += n;
+  if (got != size) {
+    // files that shrink between `fstat` and `read` are unreadable too
+    file->verdict = UNREADABLE, file->err = n == -1 ? errno : EIO;
+    close(fd);
+    return;
+  }
+
+  char *end = batch->len == 1 ? jsonw_text_par(NULL, batch->threads,
+                                               json + size, json)
+                              : jsonw_text_n(NULL, json + size, json);
+  file->verdict = end == json + size ? VALID : INVALID;
+  if (map)
+    munmap(map, size);
+  close(fd);
+}
+
+// prints the files whose text isn't as expected, in order, as soon as the
+// files before them are done. called with the lock held
+static void report(batch *batch) {
+  for (file *file; batch->printed < batch->len &&
+                   (file = batch->files + batch->printed)->done;
+       batch->printed++) {
+    batch->bytes += file->size;
+    batch->valid += file->verdict == VALID;
+    batch->invalid += file->verdict == INVALID;
+    batch->unreadable += file->verdict == UNREADABLE;
+    if (expected(file))
+      continue;
+    batch->failed++;
+    if (file->verdict == UNREADABLE)
+      printf("%s: %s\n", file->path, strerror(file->err));
+    else if (named(file, "y_") || named(file, "n_"))
+      printf("test failed: %s\n", file->path);
+    else
+      printf("invalid text: %s\n", file->path);
+  }
+}
+
+static void *worker(void *arg) {
+  batch *batch = arg;
+  char *buf = malloc(MIN_MAP);
+  if (buf == NULL)
+    perror("malloc"), exit(EXIT_FAILURE);
+  while (1) {
+    pthread_mutex_lock(&batch->lock);
+    if (batch->claimed == batch->len)
+      return pthread_mutex_unlock(&batch->lock), free(buf), NULL;
+    file *file = batch->files + batch->claimed++;
+    pthread_mutex_unlock(&batch->lock);
+
+    validate(batch, file, buf);
+    pthread_mutex_lock(&batch->lock);
+    file->done = true;
+    report(batch);
+    pthread_mutex_unlock(&batch->lock);
+  }
+}
+
+int main(int argc, char **argv) {
+  int threads = 1;
+  for (char *prog = *argv; argv[1] && argv[1][0] == '-'; argv += 2)
+    if (strcmp(argv[1], "-t") != 0 || argv[2] == NULL ||
+        (threads = atoi(argv[2])) < 1)
+      fprintf(stderr, "usage: %s [-t threads] [file.json ...]\n", prog),
+          exit(EXIT_FAILURE);
+  if (threads > JSONW_MAX_THREADS)
+    threads = JSONW_MAX_THREADS;
+
+  // file names come from the command line, or from stdin if there are none
+  batch batch = {.threads = threads};
+  bool piped = argv[1] == NULL;
+  char *line = NULL;
+  size_t cap = 0, linecap = 0;
+  while (1) {
+    char *path = piped ? NULL : *++argv;
+    if (piped) {
+      ssize_t len = getline(&line, &linecap, stdin);
+      if (len == -1)
+        break;
+      if (len && line[len - 1] == '\n')
+        line[--len] = '\0';
+      if (len == 0)
+        continue;
+      if ((path = strdup(line)) == NULL)
+        perror("strdup"), exit(EXIT_FAILURE);
+    } else if (path == NULL)
+      break;
+    if (batch.len == cap &&
+        (batch.files = realloc(batch.files,
+                               (cap = cap * 2 + 64) * sizeof(file))) == NULL)
+      perror("realloc"), exit(EXIT_FAILURE);
+    batch.files[batch.len++] = (file){.path = path};
+  }
+  if (ferror(stdin))
+    perror("getline"), exit(EXIT_FAILURE);
+  free(line);
+
+  struct timespec start, stop;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  pthread_mutex_init(&batch.lock, NULL);
+  // files are claimed one at a time, so those a thread that fails to start
+  // would have validated go to the others, this one included
+  pthread_t tids[JSONW_MAX_THREADS];
+  int started = 0;
+  while (started < threads - 1 &&
+         pthread_create(tids + started, NULL, worker, &batch) == 0)
+    started++;
+  worker(&batch);
+  while (started--)
+    pthread_join(tids[started], NULL);
+  pthread_mutex_destroy(&batch.lock);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+
+  double secs =
+      stop.tv_sec - start.tv_sec + (stop.tv_nsec - start.tv_nsec) / 1e9;
+  fprintf(stderr,
+          "%zu files, %zu bytes in %.3f s (%.1f MB/s, %.0f files/s): "
+          "%zu valid, %zu invalid, %zu unreadable, %zu not as expected\n",
+          batch.len, batch.bytes, secs, batch.bytes / 1e6 / secs,
+          batch.len / secs, batch.valid, batch.invalid, batch.unreadable,
+          batch.failed);
+  if (piped)
+    for (size_t i = 0; i < batch.len; i++)
+      free(batch.files[i].path);
+  free(batch.files);
+  return batch.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}